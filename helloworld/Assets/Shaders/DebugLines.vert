@@ -0,0 +1,20 @@
+#version 460 core
+
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec4 aColor;   // RGBA8, normalized
+
+out vec4 lineColor;
+
+layout(std140) uniform Camera   // CameraUniforms, shared by every program
+{
+	mat4 view;
+	mat4 projection;
+	mat4 viewProjection;
+};
+uniform mat4 model;
+
+void main()
+{
+	gl_Position = viewProjection * model * vec4(aPos, 1.0f);
+	lineColor = aColor;
+}
@@ -3,18 +3,26 @@
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aColor;
 layout(location = 2) in vec2 aTexCoord;
+layout(location = 3) in mat4 aInstanceModel; // locations 3-6, one per instance (RenderQueue)
 
 out vec3 ourColor;
 out vec2 texCoord;
 
-uniform mat4 view;
+layout(std140) uniform Camera   // CameraUniforms, shared by every program
+{
+	mat4 view;
+	mat4 projection;
+	mat4 viewProjection;
+};
 uniform mat4 model;
-uniform mat4 projection;
+uniform bool useInstancing;
 
 void main()
 {
+	mat4 world = useInstancing ? aInstanceModel : model;
+
 	// matrix multiplication works right to left!
-	gl_Position = projection * view * model * vec4(aPos, 1.0f); //turns it into a homogeneous coordinate so it can be transformed in any way
+	gl_Position = viewProjection * world * vec4(aPos, 1.0f); //turns it into a homogeneous coordinate so it can be transformed in any way
 	ourColor = aColor;
 	texCoord = aTexCoord;
 }
\ No newline at end of file
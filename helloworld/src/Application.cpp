@@ -15,6 +15,10 @@
 #include "TransformComponent.h"
 #include "Camera.h"
 #include "Mesh.h"
+#include "SceneBVH.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "Headless.h"
 #include <limits>
 #include <algorithm>
 
@@ -25,6 +29,9 @@ Application::Application() {
 
     LOG("Constructor Application::Application");
 
+    // Created before the modules so any of them can use it from Awake on
+    jobs = std::make_shared<JobSystem>();
+
     // Modules
     window = std::make_shared<Window>();
     guiManager = std::make_shared<GUIManager>();
@@ -34,9 +41,13 @@ Application::Application() {
     fileSystem = std::make_shared<FileSystem>();
     textures = std::make_shared<Texture>();
     camera = std::make_shared<Camera>();
+    headless = std::make_shared<Headless>();
 
     // Ordered for awake / Start / Update
     // Reverse order of CleanUp
+    // Headless first: it times PreUpdate to PostUpdate of every module (does nothing without --headless).
+    // FinishUpdate, with the wait for the pipelined extraction, falls outside that window
+    AddModule(std::static_pointer_cast<Module>(headless));
     AddModule(std::static_pointer_cast<Module>(window));
     AddModule(std::static_pointer_cast<Module>(guiManager));
     AddModule(std::static_pointer_cast<Module>(input));
@@ -110,6 +121,9 @@ bool Application::Update() {
     if (ret == true)
         ret = PreUpdate();
 
+    if (ret == true)
+        ret = DoFixedUpdate();
+
     if (ret == true)
         ret = DoUpdate();
 
@@ -133,28 +147,43 @@ bool Application::CleanUp() {
         }
     }
 
+    // after the modules: nothing can queue jobs anymore
+    jobs->Shutdown();
+
     return result;
 }
 
 // ---------------------------------------------
 void Application::PrepareUpdate()
 {
+    PROFILE_NEW_FRAME();
+    dt = clock.BeginFrame();
 }
 
 // ---------------------------------------------
 void Application::FinishUpdate()
 {
-    if (openGL && openGL->ourModel) {
-        openGL->ourModel->CleanUpDestroyedObjects();
+    //objects deleted during the frame, from any model. The pipelined
+    //extraction must be done before anything is released
+    if (openGL) {
+        PROFILE_SCOPE("FinishUpdate");
+        openGL->WaitForFrame();
+        openGL->destructionQueue->Flush();
     }
+
+    //sleep + spin until the target frame time, also with vsync off
+    PROFILE_SCOPE("FrameLimiter");
+    clock.EndFrame();
 }
 
 // Call modules before each loop iteration
 bool Application::PreUpdate()
 {
     //Iterates the module list and calls PreUpdate on each module
+    PROFILE_SCOPE("PreUpdate");
     bool result = true;
     for (const auto& module : moduleList) {
+        PROFILE_SCOPE(module->name.c_str());
         result = module->PreUpdate();
         if (!result) {
             break;
@@ -164,18 +193,40 @@ bool Application::PreUpdate()
     return result;
 }
 
+// Call modules once per fixed step accumulated this frame
+bool Application::DoFixedUpdate()
+{
+    PROFILE_SCOPE("FixedUpdate");
+    bool result = true;
+    float fixedDt = clock.GetFixedDt();
+    for (int step = 0; step < clock.GetFixedSteps() && result; ++step) {
+        for (const auto& module : moduleList) {
+            PROFILE_SCOPE(module->name.c_str());
+            result = module->FixedUpdate(fixedDt);
+            if (!result) {
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
 // Call modules on each loop iteration
 bool Application::DoUpdate()
 {
     //Iterates the module list and calls Update on each module
+    PROFILE_SCOPE("Update");
     bool result = true;
     for (const auto& module : moduleList) {
+        PROFILE_SCOPE(module->name.c_str());
         result = module->Update(dt);
         if (!result) {
             break;
         }
     }
 
+    PROFILE_SCOPE("ProcessObjectSelection");
     ProcessObjectSelection();
     return result;
 }
@@ -184,8 +235,10 @@ bool Application::DoUpdate()
 bool Application::PostUpdate()
 {
     //Iterates the module list and calls PostUpdate on each module
+    PROFILE_SCOPE("PostUpdate");
     bool result = true;
     for (const auto& module : moduleList) {
+        PROFILE_SCOPE(module->name.c_str());
         result = module->PostUpdate();
         if (!result) {
             break;
@@ -217,88 +270,15 @@ void Application::ProcessObjectSelection() {
         glm::vec3 rayDir = camera.get()->ScreenPointToRay(
             (float)mouseX, (float)mouseY, screenW, screenH);
 
-        float minDistance = std::numeric_limits<float>::max();
+        // --- 2. Consulta al BVH de la escena (solo hojas cuyo AABB cruza el rayo) ---
+        // closest triangle beyond 0.1 (AABB broad phase, then the triangle BVH of each candidate mesh)
+        // the pipelined extraction refits the BVH on a worker: join it first
+        openGL.get()->WaitForFrame();
+        SceneBVH::RaycastHit hit;
         std::shared_ptr<GameObject> hitObject = nullptr;
-
-        // --- 2. Iteracin y Test de Interseccin ---
-        for (auto& model : openGL.get()->modelObjects) {
-            // Aseguramos que las matrices de transformacin estn actualizadas antes de usarlas
-            for (auto& gameObject : model->gameObjects) {
-
-                auto transformComp = gameObject->GetComponent(ComponentType::TRANSFORM);
-                auto rendererComp = gameObject->GetComponent(ComponentType::MESH_RENDERER);
-
-                if (!transformComp || !rendererComp) continue;
-
-                auto transform = std::dynamic_pointer_cast<TransformComponent>(transformComp);
-                auto renderer = std::dynamic_pointer_cast<RenderMeshComponent>(rendererComp);
-                auto mesh = renderer->GetMesh();
-
-                if (!transform || !mesh) continue;
-
-                // Forzar actualizacin de la matriz (para evitar el error de matriz sucia)
-                transform->Update();
-                glm::mat4 modelMatrix = transform->GetGlobalTransform();
-
-                // 2.1 Obtener AABB local
-                glm::vec3 minLocal = mesh->meshAABB.min;
-                glm::vec3 maxLocal = mesh->meshAABB.max;
-
-                // 2.2 Transformacin a World AABB (re-aligned)
-                glm::vec3 worldAABB_min = glm::vec3(std::numeric_limits<float>::max());
-                glm::vec3 worldAABB_max = glm::vec3(std::numeric_limits<float>::lowest());
-
-                glm::vec3 localCorners[8] = {
-                    glm::vec3(minLocal.x, minLocal.y, minLocal.z),
-                    glm::vec3(maxLocal.x, minLocal.y, minLocal.z),
-                    glm::vec3(minLocal.x, maxLocal.y, minLocal.z),
-                    glm::vec3(maxLocal.x, maxLocal.y, minLocal.z),
-                    glm::vec3(minLocal.x, minLocal.y, maxLocal.z),
-                    glm::vec3(maxLocal.x, minLocal.y, maxLocal.z),
-                    glm::vec3(minLocal.x, maxLocal.y, maxLocal.z),
-                    glm::vec3(maxLocal.x, maxLocal.y, maxLocal.z)
-                };
-
-                for (int i = 0; i < 8; ++i) {
-                    glm::vec4 worldPos = modelMatrix * glm::vec4(localCorners[i], 1.0f);
-                    glm::vec3 worldCorner = glm::vec3(worldPos);
-                    worldAABB_min = glm::min(worldAABB_min, worldCorner);
-                    worldAABB_max = glm::max(worldAABB_max, worldCorner);
-                }
-
-                // --- 2.3 Test Ray-AABB (Slab Method) ---
-                float tmin_ray = 0.0f;
-                float tmax_ray = std::numeric_limits<float>::max();
-                bool hit = true;
-
-                for (int i = 0; i < 3; ++i) {
-                    float invD = 1.0f / rayDir[i];
-                    float t0 = (worldAABB_min[i] - rayOrigin[i]) * invD;
-                    float t1 = (worldAABB_max[i] - rayOrigin[i]) * invD;
-
-                    if (invD < 0.0f) {
-                        std::swap(t0, t1);
-                    }
-
-                    tmin_ray = std::max(t0, tmin_ray);
-                    tmax_ray = std::min(t1, tmax_ray);
-
-                    if (tmax_ray <= tmin_ray) {
-                        hit = false;
-                        break;
-                    }
-                }
-
-                if (hit) {
-                    float hitDistance = tmin_ray;
-
-                    // 2.4 Determinar el Objeto ms Cercano
-                    if (hitDistance > 0.1f && hitDistance < minDistance) {
-                        minDistance = hitDistance;
-                        hitObject = gameObject;
-                    }
-                }
-            }
+        if (openGL.get()->sceneBVH->Raycast(rayOrigin, rayDir, 0.1f, hit)) {
+            hitObject = hit.gameObject;
+            LOG("Picked '%s': triangle %u at (%.2f, %.2f, %.2f)", hitObject->GetName().c_str(), hit.triangle, hit.point.x, hit.point.y, hit.point.z);
         }
 
         // --- 3. Gestin de la Seleccin ---
@@ -3,6 +3,7 @@
 #include <memory>
 #include <list>
 #include "Module.h"
+#include "FrameClock.h"
 
 
 // Modules
@@ -16,6 +17,8 @@ class Mesh;
 class Model;
 class GUIManager;
 class Camera;
+class JobSystem;
+class Headless;
 
 
 //class Physics;
@@ -47,7 +50,7 @@ public:
 	}
 
 	int GetFPS() {
-		return framesPerSecond;
+		return (int)clock.GetStats().fps;
 	}
 
 	void ProcessObjectSelection();
@@ -71,6 +74,9 @@ private:
 	// Call modules before each loop iteration
 	bool PreUpdate();
 
+	// Call modules once per fixed step due this frame
+	bool DoFixedUpdate();
+
 	// Call modules on each loop iteration
 	bool DoUpdate();
 
@@ -104,31 +110,21 @@ public:
 	std::shared_ptr<FileSystem> fileSystem;
 	std::shared_ptr<Texture> textures;
 	std::shared_ptr<Camera> camera;
+	// --headless: offscreen context, scripted camera, frame dumps and timings
+	std::shared_ptr<Headless> headless;
+
+	// Worker threads shared by every module (hardware threads - 1)
+	std::shared_ptr<JobSystem> jobs;
+
+	// dt, fixed step accumulator and frame limiter
+	FrameClock clock;
 	
 	bool requestExit = false;
 
 private:
 
-	// Delta time
-	float dt;
-	//Frames since startup
-	int frames;
-
-	// Calculate timing measures
-	// required variables are provided:
-	/*Timer startupTime;
-	PerfTimer frameTime;
-	PerfTimer lastSecFrameTime;*/
-
-	int frameCount = 0;
-	int framesPerSecond = 0;
-	int lastSecFrameCount = 0;
-
-	float averageFps = 0.0f;
-	int secondsSinceStartup = 0;
-
-	//Maximun frame duration in miliseconds.
-	int maxFrameDuration = 16;
+	// Seconds since the previous frame (clamped, see FrameClock::maxDt)
+	float dt = 0.0f;
 
 	std::string gameTitle = "Vroom-Engine";
 };
\ No newline at end of file
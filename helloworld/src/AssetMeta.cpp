@@ -0,0 +1,48 @@
+#include "AssetMeta.h"
+#include "ContentHash.h"
+#include <fstream>
+
+bool AssetMeta::Load(const std::string& metaPath) {
+    std::ifstream file(metaPath);
+    if (!file.is_open()) return false;
+
+    bool hasUID = false;
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t separator = line.find(": ");
+        if (separator == std::string::npos) continue;
+
+        std::string key = line.substr(0, separator);
+        std::string value = line.substr(separator + 2);
+
+        try {
+            if (key == "UID") {
+                uid = std::stoull(value);
+                hasUID = true;
+            }
+            else if (key == "Time") time = std::stoll(value);
+            else if (key == "Size") size = std::stoull(value);
+            else if (key == "Hash") ContentHash::FromHex(value, hash);
+            else if (key == "ImporterVersion") importerVersion = (uint32_t)std::stoul(value);
+            else if (key == "Settings") settings = value;
+        }
+        catch (...) {
+            // Campo corrupto: se queda con su valor por defecto y fuerza re-importacion
+            if (key == "UID") hasUID = true;
+        }
+    }
+    return hasUID;
+}
+
+bool AssetMeta::Save(const std::string& metaPath) const {
+    std::ofstream file(metaPath, std::ios::trunc);
+    if (!file.is_open()) return false;
+
+    file << "UID: " << uid << "\n";
+    file << "Time: " << time << "\n";
+    file << "Size: " << size << "\n";
+    file << "Hash: " << ContentHash::ToHex(hash) << "\n";
+    file << "ImporterVersion: " << importerVersion << "\n";
+    file << "Settings: " << settings << "\n";
+    return file.good();
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include "UUID.h"
+
+// Contents of an asset's .meta file (Assets/foo.fbx -> Assets/foo.fbx.meta).
+//
+//   UID: 1234...
+//   Time: 1700000000          <- source mtime (seconds) when it was last imported
+//   Size: 52311               <- source size in bytes when it was last imported
+//   Hash: 9f2c...             <- XXH64 of the source contents (see ContentHash.h)
+//   ImporterVersion: 65537
+//   Settings: aiFlags=800008
+//
+// Old metas only have UID and Time; the missing fields load as 0/empty, which
+// makes the first startup after the upgrade re-import them once.
+struct AssetMeta {
+    VroomUUID uid = 0;
+    long long time = 0;
+    uint64_t size = 0;
+    uint64_t hash = 0;
+    uint32_t importerVersion = 0;
+    std::string settings;
+
+    // False if the file is missing or has no UID line
+    bool Load(const std::string& metaPath);
+    bool Save(const std::string& metaPath) const;
+};
@@ -77,14 +77,14 @@ glm::vec3 Camera::ScreenPointToRay(float mouseX, float mouseY, int screenW, int
 
 bool Camera::Update(float dt)
 {
-	//camera controls
+	//camera controls, in units per second so the speed doesn't depend on the frame rate
 	float cameraSpeed;
 
 
 	if (Application::GetInstance().input.get()->GetKey(SDL_SCANCODE_LSHIFT) == KEY_REPEAT)
-		cameraSpeed = 0.20f;
+		cameraSpeed = 12.0f * dt;
 	else
-		cameraSpeed = 0.05f;
+		cameraSpeed = 3.0f * dt;
 
 	xpos = Application::GetInstance().input.get()->GetMousePosition().x;
 	ypos = Application::GetInstance().input.get()->GetMousePosition().y;
@@ -262,28 +262,19 @@ void Camera::FocusObject(bool firstTime)
 		{
 			fov = 60.0f;
 
-			auto transform = std::dynamic_pointer_cast<TransformComponent>(
-				selectedObj->GetComponent(ComponentType::TRANSFORM)
-			);
+			auto transform = selectedObj->GetComponent<TransformComponent>();
 
-			auto meshRenderer = std::dynamic_pointer_cast<RenderMeshComponent>(
-				selectedObj->GetComponent(ComponentType::MESH_RENDERER)
-			);
+			auto meshRenderer = selectedObj->GetComponent<RenderMeshComponent>();
 
 			glm::vec3 finalTarget = glm::vec3(0.0f);
 			float finalDistance = 5.0f;
 
-			if (transform && meshRenderer && meshRenderer->GetMesh() && !meshRenderer->GetMesh()->vertices.empty())
+			if (transform && meshRenderer && meshRenderer->GetMesh() && meshRenderer->GetMesh()->GetVertexCount() > 0)
 			{
 				auto mesh = meshRenderer->GetMesh();
 
-				glm::vec3 minAABB(std::numeric_limits<float>::max());
-				glm::vec3 maxAABB(std::numeric_limits<float>::lowest());
-
-				for (const auto& v : mesh->vertices) {
-					minAABB = glm::min(minAABB, v.Position);
-					maxAABB = glm::max(maxAABB, v.Position);
-				}
+				glm::vec3 minAABB = mesh->meshAABB.min;
+				glm::vec3 maxAABB = mesh->meshAABB.max;
 
 				glm::mat4 globalModel = transform->GetGlobalTransform();
 				glm::vec3 corners[8] = {
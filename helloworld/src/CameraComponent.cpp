@@ -35,7 +35,7 @@ glm::mat4 CameraComponent::GetViewMatrix() const
     auto ownerPtr = owner.lock();
     if (!ownerPtr) return glm::mat4(1.0f);
 
-    auto transform = std::dynamic_pointer_cast<TransformComponent>(ownerPtr->GetComponent(ComponentType::TRANSFORM));
+    auto transform = ownerPtr->GetComponent<TransformComponent>();
 
     if (!transform) return glm::mat4(1.0f);
 
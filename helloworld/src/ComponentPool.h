@@ -0,0 +1,70 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+// Dense per-type index of components (sparse set keyed by GameObject id).
+//
+// The components are still owned by the shared_ptr in GameObject::Components
+// (serialization and the ComponentType API keep working); the pool only
+// stores raw pointers, so GetComponent<T>() is two array reads with no
+// dynamic_cast and no refcount traffic. Dense storage also lets systems
+// iterate every component of a type without walking the scene tree.
+template<typename T>
+class ComponentPool {
+public:
+    static constexpr uint32_t NoIndex = 0xFFFFFFFFu;
+
+    // Never destroyed: GameObjects may still be released during static teardown
+    static ComponentPool& Get() {
+        static ComponentPool* pool = new ComponentPool();
+        return *pool;
+    }
+
+    void Add(uint32_t entity, T* component) {
+        if (entity >= sparse.size())
+            sparse.resize(entity + 1, NoIndex);
+
+        // first one wins, same as GetComponent(ComponentType)
+        if (sparse[entity] != NoIndex)
+            return;
+
+        sparse[entity] = (uint32_t)components.size();
+        components.push_back(component);
+        entities.push_back(entity);
+    }
+
+    // swap with the last one to stay dense
+    void Remove(uint32_t entity) {
+        if (entity >= sparse.size() || sparse[entity] == NoIndex)
+            return;
+
+        uint32_t index = sparse[entity];
+        uint32_t last = (uint32_t)components.size() - 1;
+        if (index != last) {
+            components[index] = components[last];
+            entities[index] = entities[last];
+            sparse[entities[index]] = index;
+        }
+        components.pop_back();
+        entities.pop_back();
+        sparse[entity] = NoIndex;
+    }
+
+    T* Find(uint32_t entity) const {
+        if (entity >= sparse.size() || sparse[entity] == NoIndex)
+            return nullptr;
+        return components[sparse[entity]];
+    }
+
+    size_t Size() const { return components.size(); }
+    T* const* begin() const { return components.data(); }
+    T* const* end() const { return components.data() + components.size(); }
+    uint32_t GetEntity(size_t index) const { return entities[index]; }
+
+private:
+    ComponentPool() = default;
+
+    std::vector<T*> components;       // dense
+    std::vector<uint32_t> entities;   // dense, owner of components[i]
+    std::vector<uint32_t> sparse;     // entity id -> dense index
+};
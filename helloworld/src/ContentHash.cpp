@@ -0,0 +1,126 @@
+#include "ContentHash.h"
+#include "MappedFile.h"
+#include <cstring>
+#include <cstdio>
+#include <filesystem>
+
+namespace ContentHash {
+
+    static const uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+    static const uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+    static const uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+    static const uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+    static const uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+    static inline uint64_t RotL(uint64_t value, int bits) {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    // memcpy keeps unaligned reads legal; compilers turn it into a plain load
+    static inline uint64_t Read64(const uint8_t* p) { uint64_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+    static inline uint32_t Read32(const uint8_t* p) { uint32_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+
+    static inline uint64_t Round(uint64_t acc, uint64_t input) {
+        acc += input * PRIME64_2;
+        acc = RotL(acc, 31);
+        return acc * PRIME64_1;
+    }
+
+    static inline uint64_t MergeRound(uint64_t acc, uint64_t value) {
+        acc ^= Round(0, value);
+        return acc * PRIME64_1 + PRIME64_4;
+    }
+
+    uint64_t XXH64(const void* data, size_t size, uint64_t seed) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        const uint8_t* end = p + size;
+        uint64_t h;
+
+        if (size >= 32) {
+            // Four independent lanes over 32-byte stripes
+            uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+            uint64_t v2 = seed + PRIME64_2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - PRIME64_1;
+
+            const uint8_t* limit = end - 32;
+            do {
+                v1 = Round(v1, Read64(p)); p += 8;
+                v2 = Round(v2, Read64(p)); p += 8;
+                v3 = Round(v3, Read64(p)); p += 8;
+                v4 = Round(v4, Read64(p)); p += 8;
+            } while (p <= limit);
+
+            h = RotL(v1, 1) + RotL(v2, 7) + RotL(v3, 12) + RotL(v4, 18);
+            h = MergeRound(h, v1);
+            h = MergeRound(h, v2);
+            h = MergeRound(h, v3);
+            h = MergeRound(h, v4);
+        }
+        else {
+            h = seed + PRIME64_5;
+        }
+
+        h += (uint64_t)size;
+
+        while (p + 8 <= end) {
+            h ^= Round(0, Read64(p));
+            h = RotL(h, 27) * PRIME64_1 + PRIME64_4;
+            p += 8;
+        }
+        if (p + 4 <= end) {
+            h ^= (uint64_t)Read32(p) * PRIME64_1;
+            h = RotL(h, 23) * PRIME64_2 + PRIME64_3;
+            p += 4;
+        }
+        while (p < end) {
+            h ^= (*p) * PRIME64_5;
+            h = RotL(h, 11) * PRIME64_1;
+            p++;
+        }
+
+        // Avalanche
+        h ^= h >> 33;
+        h *= PRIME64_2;
+        h ^= h >> 29;
+        h *= PRIME64_3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    bool HashFile(const std::string& path, uint64_t& hash) {
+        std::error_code error;
+        uintmax_t size = std::filesystem::file_size(path, error);
+        if (error) return false;
+
+        // Empty files can't be mapped but still have a well defined hash
+        if (size == 0) {
+            hash = XXH64(nullptr, 0);
+            return true;
+        }
+
+        MappedFile file;
+        if (!file.Open(path)) return false;
+
+        hash = XXH64(file.GetData(), file.GetSize());
+        return true;
+    }
+
+    std::string ToHex(uint64_t hash) {
+        char text[17];
+        snprintf(text, sizeof(text), "%016llx", (unsigned long long)hash);
+        return text;
+    }
+
+    bool FromHex(const std::string& text, uint64_t& hash) {
+        if (text.empty() || text.size() > 16) return false;
+        try {
+            size_t used = 0;
+            hash = std::stoull(text, &used, 16);
+            return used == text.size();
+        }
+        catch (...) {
+            return false;
+        }
+    }
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+// Fast non-cryptographic content hash used to decide whether an asset changed.
+// The algorithm is XXH64 (same output as the reference xxHash implementation),
+// so values can be checked against the xxhsum tool.
+namespace ContentHash {
+
+    uint64_t XXH64(const void* data, size_t size, uint64_t seed = 0);
+
+    // Hashes the whole file through a read-only mapping. False if it can't be read.
+    bool HashFile(const std::string& path, uint64_t& hash);
+
+    std::string ToHex(uint64_t hash);
+    bool FromHex(const std::string& text, uint64_t& hash);
+}
@@ -0,0 +1,163 @@
+#include "DebugDraw.h"
+#include "ShaderManager.h"
+#include "Mesh.h"
+#include "Log.h"
+#include <chrono>
+#include "glm/gtc/type_ptr.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+uint32_t DebugDraw::PackColor(const glm::vec4& color) {
+    auto channel = [](float value) { return (uint32_t)(glm::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f); };
+    return channel(color.r) | (channel(color.g) << 8) | (channel(color.b) << 16) | (channel(color.a) << 24);
+}
+
+// position at location 0, normalized RGBA8 colour at location 1, for the bound VAO/VBO
+void DebugDraw::SetupAttributes() {
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (void*)offsetof(Vertex, color));
+}
+
+void DebugDraw::LineBuffer::Build(const std::vector<Vertex>& lineVertices) {
+    if (vao == 0) {
+        glGenVertexArrays(1, &vao);
+        glGenBuffers(1, &vbo);
+        glBindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        SetupAttributes();
+    }
+    else {
+        glBindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    }
+
+    glBufferData(GL_ARRAY_BUFFER, lineVertices.size() * sizeof(Vertex), lineVertices.data(), GL_STATIC_DRAW);
+    count = (GLsizei)lineVertices.size();
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void DebugDraw::LineBuffer::Release() {
+    if (vbo) glDeleteBuffers(1, &vbo);
+    if (vao) glDeleteVertexArrays(1, &vao);
+    vao = vbo = 0;
+    count = 0;
+}
+
+void DebugDraw::AddLine(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color) {
+    uint32_t packed = PackColor(color);
+    vertices.push_back({ from, packed });
+    vertices.push_back({ to, packed });
+}
+
+void DebugDraw::AddAABB(const AABB& box, const glm::mat4& model, const glm::vec4& color) {
+    const glm::vec3& min = box.min;
+    const glm::vec3& max = box.max;
+
+    glm::vec3 v[8];
+    for (int i = 0; i < 8; i++) {
+        glm::vec3 corner((i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z);
+        v[i] = glm::vec3(model * glm::vec4(corner, 1.0f));
+    }
+
+    // corners differing in exactly one bit share an edge
+    static const int edges[12][2] = {
+        { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 },
+        { 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 },
+        { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }
+    };
+
+    uint32_t packed = PackColor(color);
+    for (const auto& edge : edges) {
+        vertices.push_back({ v[edge[0]], packed });
+        vertices.push_back({ v[edge[1]], packed });
+    }
+}
+
+void DebugDraw::AddLines(const LineBuffer& lines, const glm::mat4& model) {
+    if (lines.IsBuilt() && lines.count > 0)
+        statics.push_back({ &lines, model });
+}
+
+bool DebugDraw::Init() {
+    if (shader)
+        return shader->ID != 0;
+
+    shader = ShaderManager::GetInstance().Load("Assets/Shaders/DebugLines.vert", "Assets/Shaders/DebugLines.frag");
+    if (shader->ID == 0)
+        LOG("DebugDraw: DebugLines shader missing or invalid, debug lines off until it is fixed");
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    SetupAttributes();
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return shader->ID != 0;
+}
+
+void DebugDraw::Flush() {
+    auto start = Clock::now();
+    stats = Stats();
+
+    if ((vertices.empty() && statics.empty()) || !Init()) {
+        vertices.clear();
+        statics.clear();
+        return;
+    }
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+
+    glUseProgram(shader->ID);
+    // the program may have been swapped by a reload since last frame
+    GLint modelLocation = shader->GetUniformLocation("model");
+
+    for (const StaticDraw& draw : statics) {
+        glUniformMatrix4fv(modelLocation, 1, GL_FALSE, glm::value_ptr(draw.model));
+        glBindVertexArray(draw.lines->vao);
+        glDrawArrays(GL_LINES, 0, draw.lines->count);
+        stats.staticLines += (uint32_t)draw.lines->count / 2;
+        stats.drawCalls++;
+    }
+
+    if (!vertices.empty()) {
+        glm::mat4 identity(1.0f);
+        glUniformMatrix4fv(modelLocation, 1, GL_FALSE, glm::value_ptr(identity));
+
+        glBindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        if (vertices.size() > capacity)
+            capacity = vertices.size() + vertices.size() / 2;
+
+        // orphan last frame's storage so the driver doesn't wait on the draw still reading it
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(Vertex), vertices.data());
+        glDrawArrays(GL_LINES, 0, (GLsizei)vertices.size());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        stats.lines = (uint32_t)vertices.size() / 2;
+        stats.drawCalls++;
+    }
+
+    glBindVertexArray(0);
+    glUseProgram((GLuint)previousProgram);
+
+    vertices.clear();
+    statics.clear();
+    stats.flushMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void DebugDraw::Release() {
+    if (vbo) glDeleteBuffers(1, &vbo);
+    if (vao) glDeleteVertexArrays(1, &vao);
+    vao = vbo = 0;
+    capacity = 0;
+
+    // the program itself goes with ShaderManager::CleanUp
+    shader = nullptr;
+}
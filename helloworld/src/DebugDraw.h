@@ -0,0 +1,85 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "glad/glad.h"
+#include "glm/glm.hpp"
+
+class Shader;
+struct AABB;
+
+// Batched debug lines (grid, selection boxes, normals) drawn by Render::debugDraw.
+//
+// Lines added during the frame (AddLine / AddAABB, already in world space) go
+// into one vertex array that Flush() streams into a single orphaned VBO and
+// draws with one glDrawArrays. Lines that don't change every frame live in a
+// LineBuffer uploaded once (the grid, a mesh's normals) and cost one draw call
+// each time they are queued with AddLines.
+//
+// Everything uses its own small shader (DebugLines.vert/.frag) with a colour
+// per vertex. GL calls only happen in Flush and LineBuffer::Build/Release.
+class DebugDraw {
+public:
+
+    struct Vertex {
+        glm::vec3 position;
+        uint32_t color;               // RGBA8, see PackColor
+    };
+
+    // Static lines on the GPU, rebuilt only when their source changes
+    class LineBuffer {
+    public:
+        void Build(const std::vector<Vertex>& vertices);
+        // Explicit, like Mesh::ReleaseGPU: owners may outlive the GL context
+        void Release();
+        bool IsBuilt() const { return vao != 0; }
+        GLsizei GetVertexCount() const { return count; }
+
+    private:
+        friend class DebugDraw;
+        GLuint vao = 0;
+        GLuint vbo = 0;
+        GLsizei count = 0;
+    };
+
+    struct Stats {
+        uint32_t lines = 0;           // streamed this frame
+        uint32_t staticLines = 0;
+        uint32_t drawCalls = 0;
+        double flushMs = 0.0;
+    };
+
+    void AddLine(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color);
+    // The 12 edges of a local space box, transformed by model
+    void AddAABB(const AABB& box, const glm::mat4& model, const glm::vec4& color);
+    // lines must stay alive (and built) until Flush
+    void AddLines(const LineBuffer& lines, const glm::mat4& model);
+
+    // Draws and clears everything added since the last Flush
+    // with the camera of OpenGL::cameraUniforms
+    void Flush();
+    void Release();
+
+    const Stats& GetStats() const { return stats; }
+
+    static uint32_t PackColor(const glm::vec4& color);
+
+private:
+
+    struct StaticDraw {
+        const LineBuffer* lines;
+        glm::mat4 model;
+    };
+
+    bool Init();
+    static void SetupAttributes();
+
+    Shader* shader = nullptr;         // owned by ShaderManager, may be hot reloaded
+
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    size_t capacity = 0;              // in vertices
+
+    std::vector<Vertex> vertices;
+    std::vector<StaticDraw> statics;
+    Stats stats;
+};
@@ -0,0 +1,122 @@
+#include "DestructionQueue.h"
+#include "Application.h"
+#include "OpenGL.h"
+#include "GUIManager.h"
+#include "GameObject.h"
+#include "RenderMeshComponent.h"
+#include "Model.h"
+#include "Log.h"
+#include <algorithm>
+#include <unordered_set>
+#include <chrono>
+#include "Profiler.h"
+
+using Clock = std::chrono::steady_clock;
+
+void DestructionQueue::Enqueue(const std::shared_ptr<GameObject>& root) {
+    if (!root || root->IsMarkedForDestroy())
+        return;
+
+    // mark the subtree now so nothing draws or picks it this frame
+    std::vector<GameObject*> stack;
+    stack.push_back(root.get());
+    while (!stack.empty()) {
+        GameObject* go = stack.back();
+        stack.pop_back();
+        go->MarkForDestroy();
+        for (auto& child : go->GetChildren())
+            if (child && !child->IsMarkedForDestroy())
+                stack.push_back(child.get());
+    }
+
+    if (auto parent = root->GetParent())
+        parent->RemoveChild(root);
+
+    pending.push_back(root);
+}
+
+void DestructionQueue::Flush() {
+    PROFILE_SCOPE("DestructionQueue::Flush");
+    if (pending.empty())
+        return;
+
+    auto start = Clock::now();
+    Application& app = Application::GetInstance();
+
+    // every object of the queued subtrees and the meshes they were using
+    std::vector<std::shared_ptr<GameObject>> doomed;
+    std::vector<std::shared_ptr<Mesh>> meshes;
+    for (auto& root : pending) {
+        size_t first = doomed.size();
+        doomed.push_back(root);
+        for (size_t i = first; i < doomed.size(); i++) {
+            GameObject* go = doomed[i].get();
+            if (auto renderer = go->GetComponent<RenderMeshComponent>())
+                if (renderer->GetMesh()) meshes.push_back(renderer->GetMesh());
+            for (auto& child : go->GetChildren())
+                if (child) doomed.push_back(child);
+        }
+    }
+    pending.clear();
+
+    auto isDoomed = [](const std::shared_ptr<GameObject>& go) { return go && go->IsMarkedForDestroy(); };
+
+    // one pass per list, for every model (not only the first one loaded)
+    for (Model* model : app.openGL->modelObjects) {
+        auto& objects = model->gameObjects;
+        objects.erase(std::remove_if(objects.begin(), objects.end(), isDoomed), objects.end());
+        if (isDoomed(model->rootGameObject))
+            model->rootGameObject.reset();
+    }
+
+    auto& sceneObjects = app.guiManager->sceneObjects;
+    sceneObjects.erase(std::remove_if(sceneObjects.begin(), sceneObjects.end(), isDoomed), sceneObjects.end());
+
+    if (isDoomed(app.guiManager->selectedObject))
+        app.guiManager->SetSelectedObject(nullptr);
+
+    if (app.openGL->gameCamera && isDoomed(app.openGL->gameCamera->GetOwner())) {
+        app.openGL->gameCamera = nullptr;
+        app.openGL->useGameCamera = false;
+    }
+
+    // last references: children die with their parent
+    uint32_t released = (uint32_t)doomed.size();
+    doomed.clear();
+
+    // meshes no live renderer uses anymore leave their model; when that was the
+    // last reference (not cached by the ResourceManager) the GL buffers go too
+    uint32_t meshesReleased = 0;
+    if (!meshes.empty()) {
+        std::sort(meshes.begin(), meshes.end());
+        meshes.erase(std::unique(meshes.begin(), meshes.end()), meshes.end());
+
+        std::unordered_set<const Mesh*> inUse;
+        for (RenderMeshComponent* renderer : ComponentPool<RenderMeshComponent>::Get())
+            inUse.insert(renderer->GetMeshPointer());
+
+        for (auto& mesh : meshes) {
+            if (inUse.count(mesh.get()))
+                continue;
+
+            for (Model* model : app.openGL->modelObjects) {
+                model->meshes.erase(std::remove(model->meshes.begin(), model->meshes.end(), mesh), model->meshes.end());
+                model->originalTextures.erase(mesh);
+            }
+
+            if (mesh.use_count() == 1) {
+                mesh->ReleaseGPU();
+                meshesReleased++;
+            }
+        }
+        meshes.clear();
+    }
+
+    stats.lastObjects = released;
+    stats.lastMeshesReleased = meshesReleased;
+    stats.totalObjects += released;
+    stats.totalMeshesReleased += meshesReleased;
+    stats.lastFlushMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    LOG("Destroyed %u GameObject(s), released %u mesh(es) (%.3f ms)", released, meshesReleased, stats.lastFlushMs);
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+class GameObject;
+
+// Scene-wide deferred destruction of GameObject subtrees.
+//
+// Enqueue() marks the whole subtree right away (drawing, picking and the
+// hierarchy panel skip marked objects) and detaches it from its parent.
+// Flush() runs at the end of the frame: it drops every reference the scene
+// keeps (any model, the hierarchy list, selection, game camera) with one
+// pass over each list, releases the subtree, and frees the GPU buffers of
+// meshes nobody uses anymore. Frames with nothing queued cost nothing.
+// Owned by the OpenGL module, main thread only.
+class DestructionQueue {
+public:
+
+    struct Stats {
+        uint32_t lastObjects = 0;          // GameObjects released by the last flush
+        uint32_t lastMeshesReleased = 0;   // meshes whose GL buffers were deleted
+        uint64_t totalObjects = 0;
+        uint64_t totalMeshesReleased = 0;
+        double lastFlushMs = 0.0;
+    };
+
+    void Enqueue(const std::shared_ptr<GameObject>& root);
+    void Flush();
+
+    bool HasPending() const { return !pending.empty(); }
+    const Stats& GetStats() const { return stats; }
+
+private:
+    std::vector<std::shared_ptr<GameObject>> pending;   // subtree roots
+    Stats stats;
+};
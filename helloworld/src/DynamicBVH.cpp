@@ -0,0 +1,283 @@
+#include "DynamicBVH.h"
+#include <algorithm>
+
+static AABB Union(const AABB& a, const AABB& b) {
+    AABB result;
+    result.min = glm::min(a.min, b.min);
+    result.max = glm::max(a.max, b.max);
+    return result;
+}
+
+// Surface area heuristic: cost of a node ~ chance a random ray/box hits it
+static float Area(const AABB& box) {
+    glm::vec3 d = box.max - box.min;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+static bool Contains(const AABB& outer, const AABB& inner) {
+    return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z
+        && inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+}
+
+AABB DynamicBVH::Fatten(const AABB& box) const {
+    glm::vec3 margin = (box.max - box.min) * fatMargin + glm::vec3(0.01f);
+    AABB fat;
+    fat.min = box.min - margin;
+    fat.max = box.max + margin;
+    return fat;
+}
+
+int DynamicBVH::AllocateNode() {
+    if (freeList == NullNode) {
+        nodes.emplace_back();
+        return int(nodes.size() - 1);
+    }
+
+    int node = freeList;
+    freeList = nodes[node].parent;
+    nodes[node] = Node();
+    return node;
+}
+
+void DynamicBVH::FreeNode(int node) {
+    nodes[node] = Node();
+    nodes[node].parent = freeList;
+    freeList = node;
+}
+
+int DynamicBVH::CreateProxy(const AABB& box, void* userData) {
+    int proxy = AllocateNode();
+    nodes[proxy].box = Fatten(box);
+    nodes[proxy].userData = userData;
+    nodes[proxy].height = 0;
+    InsertLeaf(proxy);
+    proxyCount++;
+    return proxy;
+}
+
+void DynamicBVH::DestroyProxy(int proxy) {
+    assert(proxy >= 0 && proxy < (int)nodes.size() && nodes[proxy].IsLeaf());
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    proxyCount--;
+}
+
+bool DynamicBVH::MoveProxy(int proxy, const AABB& box) {
+    const AABB& fat = nodes[proxy].box;
+    // still inside and the fat box isn't way too big (object shrank): nothing to do
+    if (Contains(fat, box) && Area(fat) <= 4.0f * Area(Fatten(box)))
+        return false;
+
+    RemoveLeaf(proxy);
+    nodes[proxy].box = Fatten(box);
+    InsertLeaf(proxy);
+    return true;
+}
+
+void DynamicBVH::Clear() {
+    nodes.clear();
+    root = NullNode;
+    freeList = NullNode;
+    proxyCount = 0;
+}
+
+void DynamicBVH::InsertLeaf(int leaf) {
+    if (root == NullNode) {
+        root = leaf;
+        nodes[root].parent = NullNode;
+        return;
+    }
+
+    // Walk down towards the cheapest sibling
+    AABB leafBox = nodes[leaf].box;
+    int index = root;
+    while (!nodes[index].IsLeaf()) {
+        int child1 = nodes[index].child1;
+        int child2 = nodes[index].child2;
+
+        float area = Area(nodes[index].box);
+        float combinedArea = Area(Union(nodes[index].box, leafBox));
+
+        // new parent here, or push the leaf further down (every ancestor grows by the same amount)
+        float cost = 2.0f * combinedArea;
+        float inheritance = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int child) {
+            float unionArea = Area(Union(leafBox, nodes[child].box));
+            if (nodes[child].IsLeaf())
+                return unionArea + inheritance;
+            return unionArea - Area(nodes[child].box) + inheritance;
+        };
+        float cost1 = descendCost(child1);
+        float cost2 = descendCost(child2);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+
+        index = cost1 < cost2 ? child1 : child2;
+    }
+
+    int sibling = index;
+    int oldParent = nodes[sibling].parent;
+    int newParent = AllocateNode();   // may reallocate nodes, no references held across it
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].box = Union(leafBox, nodes[sibling].box);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent != NullNode) {
+        if (nodes[oldParent].child1 == sibling) nodes[oldParent].child1 = newParent;
+        else nodes[oldParent].child2 = newParent;
+    }
+    else {
+        root = newParent;
+    }
+
+    // Refit and rebalance up to the root
+    index = nodes[leaf].parent;
+    while (index != NullNode) {
+        index = Balance(index);
+
+        int child1 = nodes[index].child1;
+        int child2 = nodes[index].child2;
+        nodes[index].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+        nodes[index].box = Union(nodes[child1].box, nodes[child2].box);
+
+        index = nodes[index].parent;
+    }
+}
+
+void DynamicBVH::RemoveLeaf(int leaf) {
+    if (leaf == root) {
+        root = NullNode;
+        return;
+    }
+
+    int parent = nodes[leaf].parent;
+    int grandParent = nodes[parent].parent;
+    int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grandParent == NullNode) {
+        root = sibling;
+        nodes[sibling].parent = NullNode;
+        FreeNode(parent);
+        return;
+    }
+
+    // The sibling takes the parent's place
+    if (nodes[grandParent].child1 == parent) nodes[grandParent].child1 = sibling;
+    else nodes[grandParent].child2 = sibling;
+    nodes[sibling].parent = grandParent;
+    FreeNode(parent);
+
+    int index = grandParent;
+    while (index != NullNode) {
+        index = Balance(index);
+
+        int child1 = nodes[index].child1;
+        int child2 = nodes[index].child2;
+        nodes[index].box = Union(nodes[child1].box, nodes[child2].box);
+        nodes[index].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+
+        index = nodes[index].parent;
+    }
+}
+
+// Rotates the taller child up when the heights differ by more than one. Returns the subtree root
+int DynamicBVH::Balance(int iA) {
+    Node* A = &nodes[iA];
+    if (A->IsLeaf() || A->height < 2)
+        return iA;
+
+    int iB = A->child1;
+    int iC = A->child2;
+    Node* B = &nodes[iB];
+    Node* C = &nodes[iC];
+
+    int balance = C->height - B->height;
+
+    // Rotate C up
+    if (balance > 1) {
+        int iF = C->child1;
+        int iG = C->child2;
+        Node* F = &nodes[iF];
+        Node* G = &nodes[iG];
+
+        C->child1 = iA;
+        C->parent = A->parent;
+        A->parent = iC;
+
+        if (C->parent != NullNode) {
+            if (nodes[C->parent].child1 == iA) nodes[C->parent].child1 = iC;
+            else nodes[C->parent].child2 = iC;
+        }
+        else {
+            root = iC;
+        }
+
+        if (F->height > G->height) {
+            C->child2 = iF;
+            A->child2 = iG;
+            G->parent = iA;
+            A->box = Union(B->box, G->box);
+            C->box = Union(A->box, F->box);
+            A->height = 1 + std::max(B->height, G->height);
+            C->height = 1 + std::max(A->height, F->height);
+        }
+        else {
+            C->child2 = iG;
+            A->child2 = iF;
+            F->parent = iA;
+            A->box = Union(B->box, F->box);
+            C->box = Union(A->box, G->box);
+            A->height = 1 + std::max(B->height, F->height);
+            C->height = 1 + std::max(A->height, G->height);
+        }
+        return iC;
+    }
+
+    // Rotate B up
+    if (balance < -1) {
+        int iD = B->child1;
+        int iE = B->child2;
+        Node* D = &nodes[iD];
+        Node* E = &nodes[iE];
+
+        B->child1 = iA;
+        B->parent = A->parent;
+        A->parent = iB;
+
+        if (B->parent != NullNode) {
+            if (nodes[B->parent].child1 == iA) nodes[B->parent].child1 = iB;
+            else nodes[B->parent].child2 = iB;
+        }
+        else {
+            root = iB;
+        }
+
+        if (D->height > E->height) {
+            B->child2 = iD;
+            A->child1 = iE;
+            E->parent = iA;
+            A->box = Union(C->box, E->box);
+            B->box = Union(A->box, D->box);
+            A->height = 1 + std::max(C->height, E->height);
+            B->height = 1 + std::max(A->height, D->height);
+        }
+        else {
+            B->child2 = iE;
+            A->child1 = iD;
+            D->parent = iA;
+            A->box = Union(C->box, D->box);
+            B->box = Union(A->box, E->box);
+            A->height = 1 + std::max(C->height, D->height);
+            B->height = 1 + std::max(A->height, E->height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
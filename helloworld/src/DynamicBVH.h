@@ -0,0 +1,175 @@
+#pragma once
+#include <vector>
+#include <cassert>
+#include <limits>
+#include <utility>
+#include "glm/glm.hpp"
+#include "Frustum.h"
+
+// Incremental AABB tree (same idea as the Box2D / Bullet dynamic tree).
+//
+// Every proxy is a leaf holding a "fat" box: the real box grown by a margin,
+// so objects that move a little don't touch the tree at all. When a box
+// leaves its fat box the leaf is removed and reinserted where it grows the
+// tree surface area the least, and AVL rotations keep the height O(log n).
+// Queries walk the tree with an explicit stack and call back for each leaf
+// whose fat box passes the test; the caller checks the exact box.
+class DynamicBVH {
+public:
+    static constexpr int NullNode = -1;
+
+    DynamicBVH() = default;
+
+    int CreateProxy(const AABB& box, void* userData);
+    void DestroyProxy(int proxy);
+    // True when the leaf had to be reinserted (box left its fat box)
+    bool MoveProxy(int proxy, const AABB& box);
+    void Clear();
+
+    void* GetUserData(int proxy) const { return nodes[proxy].userData; }
+    const AABB& GetFatAABB(int proxy) const { return nodes[proxy].box; }
+
+    int GetProxyCount() const { return proxyCount; }
+    int GetHeight() const { return root == NullNode ? 0 : nodes[root].height; }
+
+    // callback(int proxy) -> bool, return false to stop
+    template<typename Callback> void QueryBox(const AABB& box, Callback&& callback) const;
+    // callback(int proxy, bool inside) -> bool. inside = the fat box (so the real one too)
+    // is completely in the frustum and needs no exact test
+    template<typename Callback> void QueryFrustum(const Frustum& frustum, Callback&& callback) const;
+
+    // callback(int proxy, float maxDistance) -> float, returns the new max distance
+    // (the closest hit so far) so farther subtrees get skipped
+    template<typename Callback> void QueryRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Callback&& callback) const;
+
+    // Fraction of each box extent added on every side of the fat box
+    float fatMargin = 0.1f;
+
+private:
+
+    struct Node {
+        AABB box;
+        void* userData = nullptr;
+        int parent = NullNode;       // next free node while in the free list
+        int child1 = NullNode;
+        int child2 = NullNode;
+        int height = -1;             // 0 = leaf, -1 = free
+
+        bool IsLeaf() const { return child1 == NullNode; }
+    };
+
+    static constexpr int MaxStack = 256;   // AVL height for millions of leaves stays well below this
+
+    int AllocateNode();
+    void FreeNode(int node);
+    void InsertLeaf(int leaf);
+    void RemoveLeaf(int leaf);
+    int Balance(int node);
+    AABB Fatten(const AABB& box) const;
+
+    std::vector<Node> nodes;
+    int root = NullNode;
+    int freeList = NullNode;
+    int proxyCount = 0;
+};
+
+// Slab test. distance = entry point along the ray (0 when the origin is inside)
+inline bool IntersectRayAABB(const glm::vec3& origin, const glm::vec3& invDirection, const AABB& box, float maxDistance, float& distance) {
+    float tmin = 0.0f;
+    float tmax = maxDistance;
+    for (int i = 0; i < 3; ++i) {
+        float t0 = (box.min[i] - origin[i]) * invDirection[i];
+        float t1 = (box.max[i] - origin[i]) * invDirection[i];
+        if (invDirection[i] < 0.0f) std::swap(t0, t1);
+
+        tmin = t0 > tmin ? t0 : tmin;
+        tmax = t1 < tmax ? t1 : tmax;
+        if (tmax < tmin) return false;
+    }
+    distance = tmin;
+    return true;
+}
+
+inline bool Overlaps(const AABB& a, const AABB& b) {
+    return a.min.x <= b.max.x && a.max.x >= b.min.x
+        && a.min.y <= b.max.y && a.max.y >= b.min.y
+        && a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+template<typename Callback>
+void DynamicBVH::QueryBox(const AABB& box, Callback&& callback) const {
+    if (root == NullNode) return;
+
+    int stack[MaxStack];
+    int count = 0;
+    stack[count++] = root;
+    while (count > 0) {
+        const Node& node = nodes[stack[--count]];
+        if (!Overlaps(node.box, box)) continue;
+
+        if (node.IsLeaf()) {
+            if (!callback(int(&node - nodes.data()))) return;
+        }
+        else {
+            assert(count + 2 <= MaxStack);
+            stack[count++] = node.child1;
+            stack[count++] = node.child2;
+        }
+    }
+}
+
+template<typename Callback>
+void DynamicBVH::QueryFrustum(const Frustum& frustum, Callback&& callback) const {
+    if (root == NullNode) return;
+
+    // entries >= 0 still need the plane test, -(index + 2) = subtree known to be fully inside
+    int stack[MaxStack];
+    int count = 0;
+    stack[count++] = root;
+    while (count > 0) {
+        int entry = stack[--count];
+        bool inside = entry < 0;
+        int index = inside ? -entry - 2 : entry;
+        const Node& node = nodes[index];
+
+        if (!inside) {
+            Frustum::Result result = frustum.Classify(node.box);
+            if (result == Frustum::OUTSIDE) continue;
+            inside = result == Frustum::INSIDE;
+        }
+
+        if (node.IsLeaf()) {
+            if (!callback(index, inside)) return;
+        }
+        else {
+            assert(count + 2 <= MaxStack);
+            stack[count++] = inside ? -node.child1 - 2 : node.child1;
+            stack[count++] = inside ? -node.child2 - 2 : node.child2;
+        }
+    }
+}
+
+template<typename Callback>
+void DynamicBVH::QueryRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Callback&& callback) const {
+    if (root == NullNode) return;
+
+    glm::vec3 invDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+
+    int stack[MaxStack];
+    int count = 0;
+    stack[count++] = root;
+    while (count > 0) {
+        const Node& node = nodes[stack[--count]];
+        float distance;
+        if (!IntersectRayAABB(origin, invDirection, node.box, maxDistance, distance)) continue;
+
+        if (node.IsLeaf()) {
+            maxDistance = callback(int(&node - nodes.data()), maxDistance);
+        }
+        else {
+            assert(count + 2 <= MaxStack);
+            stack[count++] = node.child1;
+            stack[count++] = node.child2;
+        }
+    }
+}
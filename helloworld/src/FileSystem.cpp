@@ -2,6 +2,10 @@
 #include "Log.h"
 #include <algorithm>
 #include <fstream>
+#include <chrono>
+#include "Application.h"
+#include "JobSystem.h"
+#include "ContentHash.h"
 
 
 namespace fs = std::filesystem;
@@ -213,56 +217,116 @@ void FileSystem::ImportAssetsToLibrary() {
     // Ahora usamos esa ruta encontrada para buscar los archivos
     std::vector<std::string> allAssets = GetAllFiles(assetsPath, true);
 
+    using Clock = std::chrono::steady_clock;
+    auto wallStart = Clock::now();
+
+    // 1. Serie: rutas destino y carpetas (create_directories no es seguro entre hilos sobre la misma carpeta)
+    struct SyncJob {
+        std::string source;
+        std::string relativePath;
+        std::string destination;
+        bool copied = false;
+        double ms = 0.0;
+    };
+    std::vector<SyncJob> jobs;
     for (const std::string& assetPath : allAssets) {
         // Importante: No procesar lo que ya est en Library
         if (assetPath.find("/Library/") != std::string::npos) continue;
         if (GetFileExtension(assetPath) == ".meta") continue;
 
-        ProcessAsset(assetPath);
+        SyncJob job;
+        job.source = NormalizePath(assetPath);
+        if (!GetLibraryMirrorPath(job.source, job.relativePath, job.destination)) continue;
+
+        std::string destFolder = fs::path(job.destination).parent_path().string();
+        if (!Exists(destFolder)) CreateDir(destFolder);
+        jobs.push_back(job);
+    }
+
+    // 2. Paralelo: comprobar fechas y copiar, cada hilo solo escribe su propio destino
+    // (de uno en uno en el JobSystem: un archivo grande no retrasa a un bloque de pequeos)
+    unsigned int workers = Application::GetInstance().jobs->ParallelFor(jobs.size(), [&](size_t i) {
+        SyncJob& job = jobs[i];
+        auto start = Clock::now();
+        job.copied = SyncAssetFile(job.source, job.destination);
+        job.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }, 1);
+
+    // 3. Serie: .meta y resumen
+    int copiedCount = 0;
+    double serialMs = 0.0;
+    for (const SyncJob& job : jobs) {
+        serialMs += job.ms;
+        if (!job.copied) continue;
+
+        copiedCount++;
+        LOG("[FileSystem] Sincronizado Asset: %s (%.2f ms)", job.relativePath.c_str(), job.ms);
+        WriteAssetMeta(job.source, job.relativePath);
+    }
+
+    double wallMs = std::chrono::duration<double, std::milli>(Clock::now() - wallStart).count();
+    if (copiedCount > 0) {
+        LOG("[FileSystem] %d assets sincronizados en %.2f ms con %u hilos (suma por asset %.2f ms, speedup x%.2f)",
+            copiedCount, wallMs, workers, serialMs, wallMs > 0.0 ? serialMs / wallMs : 0.0);
     }
 }
 
 void FileSystem::ProcessAsset(const std::string& sourcePath) {
     std::string cleanSource = NormalizePath(sourcePath);
 
+    std::string relativePath, destination;
+    if (!GetLibraryMirrorPath(cleanSource, relativePath, destination)) return;
+
+    // Asegurar carpetas de destino
+    std::string destFolder = fs::path(destination).parent_path().string();
+    if (!Exists(destFolder)) CreateDir(destFolder);
+
+    if (SyncAssetFile(cleanSource, destination)) {
+        LOG("[FileSystem] Sincronizando Asset: %s", relativePath.c_str());
+        WriteAssetMeta(cleanSource, relativePath);
+    }
+}
+
+bool FileSystem::GetLibraryMirrorPath(const std::string& cleanSource, std::string& relativePath, std::string& destination) {
     // Encontrar dnde empieza "Assets/" para ignorar los "../" previos
     size_t assetsPos = cleanSource.find("Assets/");
-    if (assetsPos == std::string::npos) return;
+    if (assetsPos == std::string::npos) return false;
 
     // relativePath ser algo como "Textures/wood.png"
-    std::string relativePath = cleanSource.substr(assetsPos + 7); // 7 es la longitud de "Assets/"
+    relativePath = cleanSource.substr(assetsPos + 7); // 7 es la longitud de "Assets/"
 
     // El destino SIEMPRE debe ser relativo al ejecutable actual
-    std::string destination = "Assets/Library/" + relativePath + ".bin";
-    destination = NormalizePath(destination);
-
-    // Asegurar carpetas de destino
-    std::string destFolder = fs::path(destination).parent_path().string();
-    if (!Exists(destFolder)) CreateDir(destFolder);
+    destination = NormalizePath("Assets/Library/" + relativePath + ".bin");
+    return true;
+}
 
-	std::string fileName = GetFileName(cleanSource);
+bool FileSystem::SyncAssetFile(const std::string& cleanSource, const std::string& destination) {
     // 5. Verificar si el archivo necesita ser re-importado
-    if (NeedsReimport(cleanSource, destination)) {
-        LOG("[FileSystem] Sincronizando Asset: %s", relativePath.c_str());
+    if (!NeedsReimport(cleanSource, destination)) return false;
 
-        // COPIAR: En el futuro aqu llamars a funciones como ImportMesh() o ImportTexture()
-        // Por ahora, copiamos el archivo original a la carpeta espejo en Library
-        if (Copy(cleanSource, destination)) {
-
-            // 6. GESTIN DE METADATOS: Crear .meta al lado del archivo original (exterior)
-            std::string metaPath = cleanSource + ".meta";
-            if (!Exists(metaPath)) {
-                std::ofstream metaFile(metaPath);
-                if (metaFile.is_open()) {
-                    // Guardamos informacin bsica en el meta
-                    metaFile << "resource_name: " << fileName << "\n";
-                    metaFile << "original_rel_path: " << relativePath << "\n";
-                    metaFile << "import_version: 1.0\n";
-                    metaFile.close();
-                    LOG("[FileSystem] Generado meta: %s", metaPath.c_str());
-                }
-            }
-        }
+    // COPIAR: En el futuro aqu llamars a funciones como ImportMesh() o ImportTexture()
+    // Por ahora, copiamos el archivo original a la carpeta espejo en Library
+    if (!Copy(cleanSource, destination)) return false;
+
+    // La copia hereda la fecha del original: en el siguiente arranque basta con comparar fechas
+    std::error_code error;
+    fs::last_write_time(destination, fs::last_write_time(cleanSource, error), error);
+    return true;
+}
+
+void FileSystem::WriteAssetMeta(const std::string& cleanSource, const std::string& relativePath) {
+    // 6. GESTIN DE METADATOS: Crear .meta al lado del archivo original (exterior)
+    std::string metaPath = cleanSource + ".meta";
+    if (Exists(metaPath)) return;
+
+    std::ofstream metaFile(metaPath);
+    if (metaFile.is_open()) {
+        // Guardamos informacin bsica en el meta
+        metaFile << "resource_name: " << GetFileName(cleanSource) << "\n";
+        metaFile << "original_rel_path: " << relativePath << "\n";
+        metaFile << "import_version: 1.0\n";
+        metaFile.close();
+        LOG("[FileSystem] Generado meta: %s", metaPath.c_str());
     }
 }
 
@@ -274,7 +338,17 @@ bool FileSystem::NeedsReimport(const std::string& source, const std::string& des
         auto sourceTime = fs::last_write_time(source);
         auto destTime = fs::last_write_time(destination);
 
-        return sourceTime > destTime;
+        if (fs::file_size(source) != fs::file_size(destination)) return true;
+        if (sourceTime == destTime) return false;
+
+        // Fecha distinta pero mismo tamao (checkout, "touch"...): decide el contenido
+        uint64_t sourceHash = 0, destHash = 0;
+        if (!ContentHash::HashFile(source, sourceHash) || !ContentHash::HashFile(destination, destHash)) return true;
+        if (sourceHash != destHash) return true;
+
+        // Mismo contenido: sincronizamos la fecha para no volver a hashear la proxima vez
+        fs::last_write_time(destination, sourceTime);
+        return false;
     }
     catch (fs::filesystem_error& e) {
         return true; // Ante la duda, re-importamos
@@ -58,5 +58,11 @@ public:
 
 private:
     bool NeedsReimport(const std::string& source, const std::string& destination);
+
+    // Pasos de ProcessAsset por separado: ImportAssetsToLibrary ejecuta SyncAssetFile en
+    // paralelo y deja el .meta para el final, en el hilo principal
+    bool GetLibraryMirrorPath(const std::string& cleanSource, std::string& relativePath, std::string& destination);
+    bool SyncAssetFile(const std::string& cleanSource, const std::string& destination);
+    void WriteAssetMeta(const std::string& cleanSource, const std::string& relativePath);
     
 };
\ No newline at end of file
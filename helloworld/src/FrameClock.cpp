@@ -0,0 +1,77 @@
+#include "FrameClock.h"
+#include <thread>
+#include <algorithm>
+
+using Ms = std::chrono::duration<double, std::milli>;
+
+float FrameClock::BeginFrame() {
+    Clock::time_point now = Clock::now();
+
+    if (!started) {
+        // first frame: nothing to measure against, one nominal step
+        started = true;
+        secondStart = now;
+        dt = targetFps > 0 ? 1.0f / (float)targetFps : 1.0f / (float)fixedHz;
+    }
+    else {
+        stats.frameMs = Ms(now - frameStart).count();
+        dt = std::min((float)(stats.frameMs / 1000.0), maxDt);
+    }
+    frameStart = now;
+    stats.frames++;
+
+    secondFrames++;
+    double secondMs = Ms(now - secondStart).count();
+    if (secondMs >= 1000.0) {
+        stats.fps = (float)(secondFrames * 1000.0 / secondMs);
+        secondFrames = 0;
+        secondStart = now;
+    }
+
+    double step = 1.0 / std::max(1, fixedHz);
+    accumulator += dt;
+    fixedSteps = (int)(accumulator / step);
+    if (fixedSteps > maxFixedSteps) {
+        // can't keep up: drop the backlog instead of spiralling
+        fixedSteps = maxFixedSteps;
+        accumulator = 0.0;
+    }
+    else {
+        accumulator -= fixedSteps * step;
+    }
+
+    return dt;
+}
+
+void FrameClock::EndFrame() {
+    Clock::time_point workEnd = Clock::now();
+    stats.workMs = Ms(workEnd - frameStart).count();
+    stats.sleepMs = 0.0;
+    stats.spinMs = 0.0;
+
+    if (targetFps <= 0)
+        return;
+
+    Clock::time_point deadline = frameStart + std::chrono::duration_cast<Clock::duration>(Ms(1000.0 / targetFps));
+
+    // sleep while the remaining time covers the expected overshoot
+    double remaining = Ms(deadline - Clock::now()).count();
+    if (remaining > overshoot) {
+        double request = remaining - overshoot;
+        Clock::time_point before = Clock::now();
+        std::this_thread::sleep_for(Ms(request));
+        double slept = Ms(Clock::now() - before).count();
+        stats.sleepMs = slept;
+
+        // track the worst overshoot, decaying slowly when the OS behaves better
+        double error = slept - request;
+        overshoot = std::max(error, overshoot * 0.95);
+        overshoot = std::clamp(overshoot, 0.05, 20.0);
+        stats.sleepOvershootMs = overshoot;
+    }
+
+    Clock::time_point spinStart = Clock::now();
+    while (Clock::now() < deadline)
+        std::this_thread::yield();
+    stats.spinMs = Ms(Clock::now() - spinStart).count();
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+// High resolution frame timing for the main loop (Application::clock).
+//
+// BeginFrame() measures dt since the previous frame and fills the fixed step
+// accumulator; Application runs Module::FixedUpdate once per accumulated
+// step. EndFrame() is the frame limiter: it sleeps while there is enough time
+// left and spins the last stretch, since sleeps can overshoot by a whole
+// scheduler tick. The overshoot is measured, so the spin only covers what
+// the OS actually needs and the CPU idles the rest of the frame.
+class FrameClock {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats {
+        double frameMs = 0.0;         // start to start, limiter included
+        double workMs = 0.0;          // start to EndFrame, before limiting
+        double sleepMs = 0.0;         // last frame
+        double spinMs = 0.0;
+        double sleepOvershootMs = 0.0;
+        float fps = 0.0f;             // frames counted over the last second
+        uint64_t frames = 0;
+    };
+
+    // Returns dt in seconds, clamped to maxDt so a breakpoint or a long load doesn't explode the simulation
+    float BeginFrame();
+    // Waits until the target frame time is reached (no-op when targetFps is 0)
+    void EndFrame();
+
+    // Fixed steps due this frame (at most maxFixedSteps, the rest of the backlog is dropped)
+    int GetFixedSteps() const { return fixedSteps; }
+    float GetFixedDt() const { return 1.0f / (float)fixedHz; }
+    // Leftover of the accumulator in steps [0, 1), to interpolate between fixed states
+    float GetFixedAlpha() const { return (float)(accumulator * fixedHz); }
+
+    float GetDt() const { return dt; }
+    double GetTime() const { return std::chrono::duration<double>(frameStart - startTime).count(); }
+    const Stats& GetStats() const { return stats; }
+
+    int targetFps = 60;               // 0 = unlimited
+    int fixedHz = 60;
+    int maxFixedSteps = 5;
+    float maxDt = 0.25f;
+
+private:
+    Clock::time_point startTime = Clock::now();
+    Clock::time_point frameStart = startTime;
+    Clock::time_point secondStart = startTime;
+    bool started = false;
+
+    float dt = 0.0f;
+    double accumulator = 0.0;         // seconds
+    int fixedSteps = 0;
+    uint32_t secondFrames = 0;
+    double overshoot = 1.0;           // ms, worst recent sleep_for overshoot
+    Stats stats;
+};
@@ -0,0 +1,36 @@
+#include "FramePipeline.h"
+#include "Application.h"
+
+using Clock = std::chrono::steady_clock;
+
+FramePipeline::~FramePipeline() {
+    Stop();
+}
+
+void FramePipeline::Kick(std::function<void()> task) {
+    Wait();
+
+    running = true;
+    Application::GetInstance().jobs->Run([this, task = std::move(task)]() {
+        auto start = Clock::now();
+        task();
+        taskMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }, &counter);
+}
+
+void FramePipeline::Wait() {
+    if (!running)
+        return;
+
+    auto start = Clock::now();
+    Application::GetInstance().jobs->Wait(counter);
+    running = false;
+
+    stats.lastTaskMs = taskMs;
+    stats.lastWaitMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    stats.tasks++;
+}
+
+void FramePipeline::Stop() {
+    Wait();
+}
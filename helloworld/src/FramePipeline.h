@@ -0,0 +1,43 @@
+#pragma once
+#include <functional>
+#include <chrono>
+#include <cstdint>
+#include "JobSystem.h"
+
+// One job per frame for the pipelined frame mode (OpenGL::pipelinedFrames).
+//
+// The main thread kicks one task per frame (scene update + render list
+// extraction into a RenderQueue snapshot) on the Application job system and
+// waits for it at the end of the frame, before anything can mutate the scene
+// again. In between it submits the previous snapshot, renders ImGui and swaps,
+// so both overlap. The task itself may use the job system (ParallelFor).
+class FramePipeline {
+public:
+
+    struct Stats {
+        double lastTaskMs = 0.0;      // time a worker spent on the last task
+        double lastWaitMs = 0.0;      // time the main thread spent in Wait()
+        uint64_t tasks = 0;
+    };
+
+    FramePipeline() = default;
+    ~FramePipeline();
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    // Queues task on the job system. Waits for the previous one first
+    void Kick(std::function<void()> task);
+    // Until the kicked task has finished (running other jobs meanwhile), does nothing when there is none
+    void Wait();
+    bool IsRunning() const { return running; }
+    // Waits for the last task, called from OpenGL::CleanUp
+    void Stop();
+
+    const Stats& GetStats() const { return stats; }
+
+private:
+    JobSystem::Counter counter;
+    bool running = false;             // main thread view: kicked and not waited for yet
+    double taskMs = 0.0;              // written by the job, read after the counter is done
+    Stats stats;
+};
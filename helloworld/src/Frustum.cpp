@@ -0,0 +1,88 @@
+#include "Frustum.h"
+
+void Frustum::Set(const glm::mat4& m) {
+    // Gribb/Hartmann: rows of the clip matrix (glm is column major, m[col][row])
+    glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    planes[LEFT] = row3 + row0;
+    planes[RIGHT] = row3 - row0;
+    planes[BOTTOM] = row3 + row1;
+    planes[TOP] = row3 - row1;
+    planes[NEAR_PLANE] = row3 + row2;
+    planes[FAR_PLANE] = row3 - row2;
+
+    for (glm::vec4& plane : planes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f)
+            plane /= length;
+    }
+}
+
+bool Frustum::Intersects(const AABB& box) const {
+    if (!IsValid(box))
+        return true;
+
+    for (const glm::vec4& plane : planes) {
+        // corner furthest along the plane normal; if even that one is outside, the whole box is
+        glm::vec3 positive(
+            plane.x >= 0.0f ? box.max.x : box.min.x,
+            plane.y >= 0.0f ? box.max.y : box.min.y,
+            plane.z >= 0.0f ? box.max.z : box.min.z);
+
+        if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f)
+            return false;
+    }
+    return true;
+}
+
+Frustum::Result Frustum::Classify(const AABB& box) const {
+    if (!IsValid(box))
+        return INTERSECTS;
+
+    Result result = INSIDE;
+    for (const glm::vec4& plane : planes) {
+        glm::vec3 normal(plane);
+        glm::vec3 positive(
+            plane.x >= 0.0f ? box.max.x : box.min.x,
+            plane.y >= 0.0f ? box.max.y : box.min.y,
+            plane.z >= 0.0f ? box.max.z : box.min.z);
+        if (glm::dot(normal, positive) + plane.w < 0.0f)
+            return OUTSIDE;
+
+        // nearest corner behind the plane: the box straddles it
+        glm::vec3 negative(
+            plane.x >= 0.0f ? box.min.x : box.max.x,
+            plane.y >= 0.0f ? box.min.y : box.max.y,
+            plane.z >= 0.0f ? box.min.z : box.max.z);
+        if (glm::dot(normal, negative) + plane.w < 0.0f)
+            result = INTERSECTS;
+    }
+    return result;
+}
+
+bool IsValid(const AABB& box) {
+    return box.min.x <= box.max.x && box.min.y <= box.max.y && box.min.z <= box.max.z;
+}
+
+AABB TransformAABB(const AABB& local, const glm::mat4& transform) {
+    if (!IsValid(local))
+        return local;
+
+    glm::vec3 translation(transform[3]);
+    AABB world;
+    world.min = translation;
+    world.max = translation;
+
+    for (int col = 0; col < 3; col++) {
+        for (int row = 0; row < 3; row++) {
+            float a = transform[col][row] * local.min[col];
+            float b = transform[col][row] * local.max[col];
+            world.min[row] += glm::min(a, b);
+            world.max[row] += glm::max(a, b);
+        }
+    }
+    return world;
+}
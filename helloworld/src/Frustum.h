@@ -0,0 +1,34 @@
+#pragma once
+#include "glm/glm.hpp"
+#include "Mesh.h"
+
+// View frustum as 6 planes (ax + by + cz + d >= 0 inside), taken from a
+// projection * view matrix. Used to skip meshes the camera can't see.
+class Frustum {
+public:
+
+    enum Plane { LEFT = 0, RIGHT, BOTTOM, TOP, NEAR_PLANE, FAR_PLANE, PLANE_COUNT };
+
+    Frustum() = default;
+    explicit Frustum(const glm::mat4& viewProjection) { Set(viewProjection); }
+
+    void Set(const glm::mat4& viewProjection);
+
+    enum Result { OUTSIDE = 0, INTERSECTS, INSIDE };
+
+    // Conservative: may accept boxes just outside a corner, never rejects a visible one
+    bool Intersects(const AABB& box) const;
+    // Same test, but also tells when the box is completely inside (its contents need no more tests)
+    Result Classify(const AABB& box) const;
+
+    const glm::vec4& GetPlane(int plane) const { return planes[plane]; }
+
+private:
+    glm::vec4 planes[PLANE_COUNT];
+};
+
+// An empty AABB (min > max, mesh without vertices) is left as is
+bool IsValid(const AABB& box);
+
+// World space box enclosing the transformed local box (Arvo's method, no corner loop)
+AABB TransformAABB(const AABB& local, const glm::mat4& transform);
@@ -13,10 +13,17 @@
 #include "MaterialComponent.h"
 #include "CameraComponent.h"
 #include "Textures.h"
+#include "TextureStreamer.h"
+#include "TextureCache.h"
 #include "Render.h"
+#include "SceneBVH.h"
 #include "ResMan.h"
 
 #include "SceneSerializer.h"
+#include "PoolAllocator.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "ShaderManager.h"
 #include <SDL3/SDL_opengl.h>
 #include <glm/glm.hpp>
 #include <assimp/version.h>
@@ -26,6 +33,8 @@
 #include <glm/gtx/transform.hpp>
 
 #include <vector>
+#include <map>
+#include <string_view>
 
 namespace fs = std::filesystem;
 
@@ -48,6 +57,7 @@ void GUIElement::ElementSetUp()
 	case ElementType::Additional:
 		//additional handles popup windows
 		AboutSetUp();
+		if (Application::GetInstance().guiManager.get()->showRenderStats) RenderStatsSetUp();
 		break;
 	case ElementType::MenuBar:
 		MenuBarSetUp();
@@ -67,6 +77,9 @@ void GUIElement::ElementSetUp()
 	case ElementType::Asset:
 		if (Application::GetInstance().guiManager.get()->showAssets) AssetSetUp(&Application::GetInstance().guiManager.get()->showAssets);
 		break;
+	case ElementType::ProfilerPanel:
+		if (Application::GetInstance().guiManager.get()->showProfiler) ProfilerSetUp(&Application::GetInstance().guiManager.get()->showProfiler);
+		break;
 	default:
 		LOG("No GUIType detected.");
 		break;
@@ -101,7 +114,7 @@ void GUIElement::MenuBarSetUp()
 
 			if (ImGui::MenuItem("Load Scene", "Ctrl+O")) {
 				// 1. Crear un objeto vacío para recibir los datos
-				auto newRoot = std::make_shared<GameObject>("LoadedSceneRoot");
+				auto newRoot = MakePooled<GameObject>("LoadedSceneRoot");
 
 				// 2. Cargar
 				SceneSerializer::LoadScene("Assets/Scenes/MyScene.json", newRoot);
@@ -115,6 +128,14 @@ void GUIElement::MenuBarSetUp()
 				bool set = !Application::GetInstance().guiManager.get()->showAssets;
 				Application::GetInstance().guiManager.get()->showAssets = set;
 			}
+			if (ImGui::MenuItem("Configuration", nullptr, Application::GetInstance().guiManager.get()->showConfig)) {
+				bool set = !Application::GetInstance().guiManager.get()->showConfig;
+				Application::GetInstance().guiManager.get()->showConfig = set;
+			}
+			if (ImGui::MenuItem("Profiler", nullptr, Application::GetInstance().guiManager.get()->showProfiler)) {
+				bool set = !Application::GetInstance().guiManager.get()->showProfiler;
+				Application::GetInstance().guiManager.get()->showProfiler = set;
+			}
 
 			ImGui::Separator();
 			// --------------------------------------
@@ -166,23 +187,19 @@ void GUIElement::MenuBarSetUp()
 			ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.2f, 0.8f, 0.2f, 1.0f));
 			if (ImGui::Button("PLAY"))
 			{
-				std::shared_ptr<CameraComponent> foundCam = nullptr;
+				CameraComponent* foundCam = nullptr;
 				for (auto& obj : Application::GetInstance().guiManager->sceneObjects)
 				{
 					
 					if (!obj) continue;
 
-					auto component = obj->GetComponent(ComponentType::CAMERA);
-					if (component)
-					{
-						foundCam = std::dynamic_pointer_cast<CameraComponent>(component);
-						if (foundCam) break;
-					}
+					foundCam = obj->GetComponent<CameraComponent>();
+					if (foundCam) break;
 				}
 
 				if (foundCam)
 				{
-					openGL->gameCamera = foundCam.get();
+					openGL->gameCamera = foundCam;
 					openGL->useGameCamera = true;
 					LOG("Switching to Game Camera.");
 				}
@@ -292,8 +309,17 @@ void GUIElement::ConfigSetUp(bool* show) {
 	}
 
 	//show fps
-	//ImGui::Text("FPS: %d", Application::GetInstance().GetFPS());
-	ImGui::Text("FPS: %.1f (%.1f ms/frame)", ImGui::GetIO().Framerate, 1000.0f / ImGui::GetIO().Framerate);
+	FrameClock& frameClock = Application::GetInstance().clock;
+	const FrameClock::Stats& clockStats = frameClock.GetStats();
+	ImGui::Text("FPS: %.1f (%.2f ms/frame, dt %.4f s)", clockStats.fps, clockStats.frameMs, frameClock.GetDt());
+	ImGui::BulletText("Work: %.2f ms, sleep: %.2f ms, spin: %.2f ms (sleep overshoot %.2f ms)", clockStats.workMs,
+		clockStats.sleepMs, clockStats.spinMs, clockStats.sleepOvershootMs);
+	ImGui::SliderInt("Frame limit (0 = off)", &frameClock.targetFps, 0, 360);
+	ImGui::SliderInt("Fixed step (Hz)", &frameClock.fixedHz, 10, 240);
+	Render* renderModule = Application::GetInstance().render.get();
+	bool vsync = renderModule->GetVSync();
+	if (ImGui::Checkbox("VSync", &vsync))
+		renderModule->SetVSync(vsync);
 	ImGui::Separator();
 
 	//variable config
@@ -343,6 +369,140 @@ void GUIElement::ConfigSetUp(bool* show) {
 	ImGui::BulletText("CPU Cores: %u", GetCPUCoreCount());
 	ImGui::Separator();
 
+	//model loading: assimp vs library package
+	ImGui::Text("Model Loading:");
+	Model* benchModel = Application::GetInstance().openGL.get()->ourModel;
+	if (ImGui::Button("Benchmark Assimp vs Library") && benchModel) {
+		ResourceManager::GetInstance().BenchmarkModelLoad(benchModel->fullPath);
+	}
+	const auto& modelBench = ResourceManager::GetInstance().GetLastModelBenchmark();
+	if (modelBench.iterations > 0) {
+		ImGui::BulletText("%s (%d runs)", modelBench.assetPath.c_str(), modelBench.iterations);
+		ImGui::BulletText("Assimp: %.2f ms first, %.2f ms avg", modelBench.assimpColdMs, modelBench.assimpAvgMs);
+		ImGui::BulletText("Library: %.2f ms first, %.2f ms avg", modelBench.packageColdMs, modelBench.packageAvgMs);
+	}
+	ImGui::Separator();
+
+	//render queue: sorted draw items and the GL state changes they cost
+	RenderQueue& renderQueue = Application::GetInstance().render.get()->renderQueue;
+	ImGui::Text("Render Queue:");
+	ImGui::Checkbox("Sort draw calls by state", &renderQueue.settings.sortItems);
+	ImGui::Checkbox("GPU instancing", &renderQueue.settings.useInstancing);
+	ImGui::Checkbox("Frustum culling", &renderQueue.settings.frustumCulling);
+	ImGui::Checkbox("Show render counters overlay", &Application::GetInstance().guiManager.get()->showRenderStats);
+	const RenderQueue::Stats& queueStats = renderQueue.GetStats();
+	ImGui::BulletText("Visible meshes: %u, culled: %u", queueStats.items, queueStats.culled);
+	ImGui::BulletText("Draw calls: %u (%u instanced, %u instances)", queueStats.drawCalls, queueStats.instancedDraws, queueStats.instances);
+	ImGui::BulletText("Program switches: %u, texture binds: %u, VAO binds: %u", queueStats.programSwitches, queueStats.textureBinds, queueStats.vaoBinds);
+	ImGui::BulletText("Extract: %.3f ms, submit: %.3f ms", queueStats.extractMs, queueStats.submitMs);
+	const DebugDraw::Stats& debugStats = Application::GetInstance().render->debugDraw.GetStats();
+	ImGui::BulletText("Debug lines: %u streamed + %u static in %u draw call(s)", debugStats.lines, debugStats.staticLines, debugStats.drawCalls);
+	ImGui::Separator();
+
+	//shader programs: Library binaries and hot reload of Assets/Shaders
+	ShaderManager& shaders = ShaderManager::GetInstance();
+	const ShaderManager::Stats& shaderStats = shaders.GetStats();
+	ImGui::Text("Shaders:");
+	ImGui::Checkbox("Hot reload", &shaders.hotReload);
+	ImGui::SameLine();
+	if (ImGui::Button("Reload all"))
+		shaders.ReloadAll();
+	ImGui::BulletText("Programs: %u, loaded in %.2f ms (%u from Library binaries, %u compiled)", shaderStats.programs,
+		shaderStats.startupMs, shaderStats.binaryHits, shaderStats.compiled);
+	ImGui::BulletText("Reloads: %u, failed builds: %u, parallel compile: %s", shaderStats.reloads, shaderStats.failed,
+		shaderStats.parallelCompile ? "yes" : "no");
+	ImGui::Separator();
+
+	//job system: worker stats, stress test and scaling benchmark
+	JobSystem& jobs = *Application::GetInstance().jobs;
+	JobSystem::Stats jobStats = jobs.GetStats();
+	ImGui::Text("Job System:");
+	ImGui::BulletText("Workers: %u (+ main thread), jobs run: %llu, stolen: %llu", jobs.GetWorkerCount(),
+		(unsigned long long)jobStats.executed, (unsigned long long)jobStats.stolen);
+	if (ImGui::Button("Stress test"))
+		jobs.lastStress = jobs.StressTest();
+	ImGui::SameLine();
+	if (ImGui::Button("Benchmark scaling"))
+		jobs.lastScaling = JobSystem::BenchmarkScaling();
+	if (jobs.lastStress.jobs > 0) {
+		if (jobs.lastStress.passed)
+			ImGui::BulletText("Stress test passed: %llu jobs in %.2f ms", (unsigned long long)jobs.lastStress.jobs, jobs.lastStress.ms);
+		else
+			ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "Stress test failed: %s", jobs.lastStress.failure.c_str());
+	}
+	for (const JobSystem::ScalingResult& result : jobs.lastScaling)
+		ImGui::BulletText("%u thread(s): %.2f ms (x%.2f)", result.threads, result.ms, result.speedup);
+	ImGui::Separator();
+
+	//frame pipeline: extraction of the next frame overlapped with submit/ImGui/swap
+	OpenGL* openGLModule = Application::GetInstance().openGL.get();
+	ImGui::Text("Frame Pipeline:");
+	ImGui::Checkbox("Pipelined frames (1 frame latency)", &openGLModule->pipelinedFrames);
+	if (openGLModule->pipelinedFrames) {
+		const FramePipeline::Stats& pipelineStats = openGLModule->framePipeline.GetStats();
+		ImGui::BulletText("Worker: %.3f ms, main thread waited %.3f ms", pipelineStats.lastTaskMs, pipelineStats.lastWaitMs);
+	}
+	ImGui::Separator();
+
+	//transform hierarchy: batched world matrix pass
+	const TransformSystem::Stats& transformStats = TransformSystem::GetInstance().GetStats();
+	ImGui::Text("Transforms:");
+	ImGui::BulletText("Count: %zu, updated last pass: %u (%.3f ms)", transformStats.count, transformStats.lastUpdated, transformStats.lastUpdateMs);
+	ImGui::BulletText("Passes: %u, re-sorts: %u", transformStats.updates, transformStats.reorders);
+	ImGui::Separator();
+
+	//slab pools for GameObjects/components, compare heap calls with pooling off
+	const PoolArena::Stats& poolStats = PoolArena::GetGlobalStats();
+	ImGui::Text("Object Pools:");
+	ImGui::Checkbox("Pool GameObjects and components", &PoolArena::enabled);
+	ImGui::BulletText("Allocations: %llu, frees: %llu, heap calls: %llu", (unsigned long long)poolStats.allocations,
+		(unsigned long long)poolStats.frees, (unsigned long long)poolStats.heapAllocations);
+	ImGui::BulletText("Slab memory: %.2f MB", poolStats.slabBytes / (1024.0 * 1024.0));
+	const DestructionQueue::Stats& destroyStats = Application::GetInstance().openGL->destructionQueue->GetStats();
+	ImGui::BulletText("Destroyed: %llu objects, %llu meshes released (last flush %.3f ms)", (unsigned long long)destroyStats.totalObjects,
+		(unsigned long long)destroyStats.totalMeshesReleased, destroyStats.lastFlushMs);
+	ImGui::Separator();
+
+	//scene BVH: picking queries + brute force comparison
+	auto sceneBVH = Application::GetInstance().openGL.get()->sceneBVH;
+	ImGui::Text("Scene BVH:");
+	ImGui::BulletText("Leaves: %d, height: %d, refitted last frame: %u", sceneBVH->GetTree().GetProxyCount(), sceneBVH->GetTree().GetHeight(), sceneBVH->GetLastUpdateCount());
+	ImGui::Checkbox("Precise picking (triangle BVH)", &sceneBVH->precisePicking);
+	if (ImGui::Button("Benchmark BVH vs brute force (1k/10k/100k)")) {
+		sceneBVH->lastBenchmark.clear();
+		for (int count : { 1000, 10000, 100000 })
+			sceneBVH->lastBenchmark.push_back(SceneBVH::Benchmark(count));
+	}
+	for (const SceneBVH::BenchmarkResult& bench : sceneBVH->lastBenchmark) {
+		ImGui::BulletText("%d objects: build %.2f ms", bench.objectCount, bench.buildMs);
+		ImGui::Indent();
+		ImGui::Text("Ray: %.4f ms brute, %.4f ms BVH (x%.1f)", bench.bruteRayMs, bench.bvhRayMs, bench.bvhRayMs > 0.0 ? bench.bruteRayMs / bench.bvhRayMs : 0.0);
+		ImGui::Text("Frustum (%.0f%% visible): %.4f ms brute, %.4f ms BVH (x%.1f)", bench.visibleFraction * 100.0, bench.bruteFrustumMs, bench.bvhFrustumMs, bench.bvhFrustumMs > 0.0 ? bench.bruteFrustumMs / bench.bvhFrustumMs : 0.0);
+		if (bench.mismatches > 0) ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%d queries disagree", bench.mismatches);
+		ImGui::Unindent();
+	}
+	ImGui::Separator();
+
+	//texture streaming: decode threads + upload queue
+	auto streamer = Application::GetInstance().textures.get()->streamer;
+	if (streamer) {
+		ImGui::Text("Texture Streaming:");
+		ImGui::SliderFloat("Upload budget (ms)", &streamer->uploadBudgetMs, 0.1f, 16.0f);
+		ImGui::Checkbox("Upload through PBO", &streamer->usePixelBuffers);
+		TextureStreamer::Stats texStats = streamer->GetStats();
+		ImGui::BulletText("Pending: %d decoding, %d waiting upload", (int)texStats.pendingDecodes, (int)texStats.pendingUploads);
+		ImGui::BulletText("Last frame: %u uploads, %.2f ms", texStats.lastFrameUploads, texStats.lastFrameUploadMs);
+		ImGui::BulletText("Uploaded: %llu (%llu from Library BCn), failed: %llu", (unsigned long long)texStats.uploaded,
+			(unsigned long long)texStats.uploadedCompressed, (unsigned long long)texStats.failed);
+
+		auto textureCache = Application::GetInstance().textures.get()->cache;
+		ImGui::BulletText("Cached textures: %d (%d unused)", (int)textureCache->GetCount(), (int)textureCache->GetUnusedCount());
+		if (ImGui::Button("Evict unused textures")) {
+			textureCache->EvictUnused();
+		}
+		ImGui::Separator();
+	}
+
 	//software versions 
 	ImGui::Text("Software Versions:");
 	ImGui::BulletText("SDL3: %d.%d", SDL_MAJOR_VERSION, SDL_MINOR_VERSION);
@@ -359,6 +519,189 @@ void GUIElement::ConfigSetUp(bool* show) {
 	ImGui::End();
 }
 
+void GUIElement::RenderStatsSetUp()
+{
+	const RenderQueue::Stats& stats = Application::GetInstance().render.get()->renderQueue.GetStats();
+
+	//small transparent box in the top right corner of the main viewport
+	const ImGuiViewport* viewport = ImGui::GetMainViewport();
+	ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + viewport->WorkSize.x - 10.0f, viewport->WorkPos.y + 10.0f), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+	ImGui::SetNextWindowBgAlpha(0.35f);
+
+	ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoInputs |
+		ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoDocking;
+	if (ImGui::Begin("Render Counters", nullptr, flags)) {
+		ImGui::Text("Visible: %u  Culled: %u", stats.items, stats.culled);
+		ImGui::Text("Draw calls: %u", stats.drawCalls);
+		ImGui::Text("Instanced: %u calls, %u instances", stats.instancedDraws, stats.instances);
+		ImGui::Text("Program switches: %u", stats.programSwitches);
+		ImGui::Text("Texture binds: %u", stats.textureBinds);
+		ImGui::Text("VAO binds: %u", stats.vaoBinds);
+		ImGui::Text("Submit: %.3f ms", stats.submitMs);
+	}
+	ImGui::End();
+}
+
+void GUIElement::ProfilerSetUp(bool* show)
+{
+	//initial states
+	ImGui::SetNextWindowDockID(0, ImGuiCond_FirstUseEver);
+	ImGui::SetNextWindowSize(ImVec2(700, 450), ImGuiCond_FirstUseEver);
+
+	if (!ImGui::Begin("Profiler", show))
+	{
+		ImGui::End();
+		return;
+	}
+
+#ifndef VROOM_PROFILING
+	ImGui::TextDisabled("Built without VROOM_PROFILING, no scopes are recorded.");
+#endif
+
+	Profiler& profiler = Profiler::GetInstance();
+	ImGui::Checkbox("Record", &profiler.enabled);
+	ImGui::SameLine();
+	ImGui::Checkbox("Pause", &profiler.paused);
+	ImGui::SameLine();
+	if (ImGui::Button("Export Chrome trace"))
+		profiler.ExportChromeTrace("profile_trace.json");
+	ImGui::SameLine();
+	ImGui::TextDisabled("(profile_trace.json, open in chrome://tracing or ui.perfetto.dev)");
+
+	int frameCount = (int)profiler.GetFrameCount();
+	if (frameCount == 0) {
+		ImGui::Text("No frames recorded yet.");
+		ImGui::End();
+		return;
+	}
+	profilerFrameAge = std::clamp(profilerFrameAge, 0, frameCount - 1);
+
+	//frame times, oldest to newest. Click a bar to inspect that frame
+	std::vector<float> frameMs(frameCount);
+	float maxMs = 0.0f;
+	for (int i = 0; i < frameCount; ++i) {
+		const Profiler::Frame& frame = profiler.GetFrame(frameCount - 1 - i);
+		frameMs[i] = (frame.end - frame.start) / 1000000.0f;
+		maxMs = std::max(maxMs, frameMs[i]);
+	}
+	ImGui::PlotHistogram("##frameTimes", frameMs.data(), frameCount, 0, "Frame times (ms)", 0.0f, maxMs * 1.1f, ImVec2(-1, 60));
+	if (ImGui::IsItemHovered() && ImGui::IsMouseClicked(ImGuiMouseButton_Left)) {
+		float t = (ImGui::GetIO().MousePos.x - ImGui::GetItemRectMin().x) / ImGui::GetItemRectSize().x;
+		profilerFrameAge = frameCount - 1 - std::clamp((int)(t * frameCount), 0, frameCount - 1);
+	}
+	ImGui::SliderInt("Frame age", &profilerFrameAge, 0, frameCount - 1);
+	ImGui::SliderFloat("Zoom", &profilerZoom, 1.0f, 50.0f, "x%.1f", ImGuiSliderFlags_Logarithmic);
+
+	//timeline of the selected frame: one lane per thread (main first), one row per nesting level
+	const Profiler::Frame& frame = profiler.GetFrame(profilerFrameAge);
+	double frameNs = (double)std::max<int64_t>(1, frame.end - frame.start);
+	ImGui::Text("Frame %llu: %.3f ms, %zu scopes", (unsigned long long)frame.index, frameNs / 1000000.0, frame.events.size());
+
+	size_t threadCount = profiler.GetThreadCount();
+	uint16_t mainThread = profiler.GetMainThread();
+	std::vector<int> laneRows(threadCount, 0);
+	for (const Profiler::Event& event : frame.events)
+		if (event.thread < threadCount) laneRows[event.thread] = std::max(laneRows[event.thread], event.depth + 1);
+
+	const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+	std::vector<float> laneY(threadCount, 0.0f);
+	float totalHeight = 0.0f;
+	for (size_t pass = 0; pass < 2; ++pass) {
+		for (size_t t = 0; t < threadCount; ++t) {
+			if ((t == mainThread) != (pass == 0) || laneRows[t] == 0) continue;
+			laneY[t] = totalHeight + rowHeight;
+			totalHeight += rowHeight * (laneRows[t] + 1);
+		}
+	}
+
+	ImGui::BeginChild("##timeline", ImVec2(0, std::min(totalHeight + 20.0f, 300.0f)), true, ImGuiWindowFlags_HorizontalScrollbar);
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	ImVec2 origin = ImGui::GetCursorScreenPos();
+	float width = ImGui::GetContentRegionAvail().x * profilerZoom;
+
+	for (size_t t = 0; t < threadCount; ++t) {
+		if (laneRows[t] == 0) continue;
+		std::string label = t == mainThread ? "Main thread" : "Worker " + std::to_string(t);
+		drawList->AddText(ImVec2(ImGui::GetScrollX() + origin.x, origin.y + laneY[t] - rowHeight), ImGui::GetColorU32(ImGuiCol_TextDisabled), label.c_str());
+	}
+
+	for (const Profiler::Event& event : frame.events) {
+		if (event.thread >= threadCount) continue;
+		float x0 = origin.x + (float)((event.start - frame.start) / frameNs) * width;
+		float x1 = origin.x + (float)((event.end - frame.start) / frameNs) * width;
+		x1 = std::max(x1, x0 + 1.0f);
+		float y0 = origin.y + laneY[event.thread] + event.depth * rowHeight;
+		ImVec2 min(x0, y0), max(x1, y0 + rowHeight - 1.0f);
+
+		//same name = same colour in every frame
+		float hue = (float)(std::hash<std::string_view>()(event.name) % 360) / 360.0f;
+		drawList->AddRectFilled(min, max, (ImU32)ImColor::HSV(hue, 0.5f, 0.75f));
+		if (x1 - x0 > 20.0f) {
+			drawList->PushClipRect(min, max, true);
+			drawList->AddText(ImVec2(x0 + 2.0f, y0 + 1.0f), IM_COL32(0, 0, 0, 255), event.name);
+			drawList->PopClipRect();
+		}
+		if (ImGui::IsMouseHoveringRect(min, max))
+			ImGui::SetTooltip("%s\n%.3f ms%s%s", event.name, (event.end - event.start) / 1000000.0,
+				event.parent ? "\nin " : "", event.parent ? event.parent : "");
+	}
+	ImGui::Dummy(ImVec2(width, totalHeight));
+	ImGui::EndChild();
+
+	//rolling averages over the whole history, per scope and enclosing scope (names are
+	//literals or Module::name, so their pointers are stable keys)
+	struct ScopeTotals {
+		double totalMs = 0.0;
+		double maxMs = 0.0;
+		uint64_t calls = 0;
+	};
+	std::map<std::pair<const char*, const char*>, ScopeTotals> totals;
+	std::map<std::pair<const char*, const char*>, double> frameTotals;
+	for (int age = 0; age < frameCount; ++age) {
+		frameTotals.clear();
+		for (const Profiler::Event& event : profiler.GetFrame(age).events) {
+			auto key = std::make_pair(event.parent, event.name);
+			double ms = (event.end - event.start) / 1000000.0;
+			frameTotals[key] += ms;
+			totals[key].calls++;
+		}
+		for (auto& [key, ms] : frameTotals) {
+			ScopeTotals& scope = totals[key];
+			scope.totalMs += ms;
+			scope.maxMs = std::max(scope.maxMs, ms);
+		}
+	}
+
+	std::vector<std::pair<std::string, ScopeTotals>> rows;
+	for (auto& [key, scope] : totals)
+		rows.push_back({ key.first ? std::string(key.first) + " / " + key.second : std::string(key.second), scope });
+	std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) { return a.second.totalMs > b.second.totalMs; });
+
+	ImGui::Text("Averages over %d frames:", frameCount);
+	if (ImGui::BeginTable("##profilerAverages", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable)) {
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("Scope");
+		ImGui::TableSetupColumn("Avg ms/frame");
+		ImGui::TableSetupColumn("Max ms");
+		ImGui::TableSetupColumn("Calls/frame");
+		ImGui::TableHeadersRow();
+		for (const auto& [name, scope] : rows) {
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(name.c_str());
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", scope.totalMs / frameCount);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", scope.maxMs);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", (double)scope.calls / frameCount);
+		}
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+}
+
 void GUIElement::HierarchySetUp(bool* show)
 {
 	ImGuiWindowFlags window_flags = ImGuiWindowFlags_None;
@@ -723,7 +1066,7 @@ void GUIElement::InspectorSetUp(bool* show)
 
 		//transform
 		//get transform component
-		auto transform = std::dynamic_pointer_cast<TransformComponent>(selected->GetComponent(ComponentType::TRANSFORM));
+		auto transform = selected->GetComponent<TransformComponent>();
 		if (transform) {
 			if (ImGui::CollapsingHeader("Transform")) {
 				glm::vec3 pos = transform->GetPosition();
@@ -744,28 +1087,26 @@ void GUIElement::InspectorSetUp(bool* show)
 
 		//mesh
 		//get mesh component
-		auto meshComponent = std::dynamic_pointer_cast<RenderMeshComponent>(selected->GetComponent(ComponentType::MESH_RENDERER));
+		auto meshComponent = selected->GetComponent<RenderMeshComponent>();
 		//get texture for next step
-		vector<Texture> textureComponent;
+		vector<TextureHandle> textureComponent;
 
 		bool showFaceNormals = manager->drawFaceNormals;
 		bool showVertNormals = manager->drawVertNormals;
 
 
 		if (meshComponent) {
-			std::shared_ptr<Mesh> mesh = meshComponent.get()->GetMesh();
+			std::shared_ptr<Mesh> mesh = meshComponent->GetMesh();
 			if (mesh) textureComponent = mesh.get()->textures;
 
 			//check if header is open
 			if (ImGui::CollapsingHeader("Mesh")) {
 				//get values
-				std::shared_ptr<Mesh> mesh = meshComponent.get()->GetMesh();
-				vector<Vertex> vert = mesh.get()->vertices;
-				vector<unsigned int> ind = mesh.get()->indices;
+				std::shared_ptr<Mesh> mesh = meshComponent->GetMesh();
 
 				//display values
-				ImGui::Text("Vertices: %d", vert.size());
-				ImGui::Text("Indices: %d", ind.size());
+				ImGui::Text("Vertices: %d", (int)mesh.get()->GetVertexCount());
+				ImGui::Text("Indices: %d", (int)mesh.get()->GetIndexCount());
 
 				//show normals 
 				ImGui::Checkbox("Show Vertex Normals", &mesh.get()->drawFaceNormals);
@@ -775,16 +1116,20 @@ void GUIElement::InspectorSetUp(bool* show)
 			//texture
 			if (ImGui::CollapsingHeader("Texture")) {
 				// Show current texture info
-				auto materialComp = std::dynamic_pointer_cast<MaterialComponent>(
-					selected->GetComponent(ComponentType::MATERIAL)
-				);
+				auto materialComp = selected->GetComponent<MaterialComponent>();
 
 				if (materialComp && materialComp->GetDiffuseMap()) {
-					auto currentTex = materialComp->GetDiffuseMap();
-					ImGui::Text("Current Texture ID: %u", currentTex->id);
-					ImGui::BulletText("Path: %s", currentTex->path.c_str());
-					ImGui::BulletText("Width: %d", currentTex->texW);
-					ImGui::BulletText("Height: %d", currentTex->texH);
+					TextureHandle currentTex = materialComp->GetDiffuseMap();
+					ImGui::Text("Current Texture ID: %u", currentTex.GetId());
+					ImGui::BulletText("Path: %s", currentTex.GetPath().c_str());
+					int texW = 0, texH = 0;
+					if (currentTex.GetSize(texW, texH)) {
+						ImGui::BulletText("Width: %d", texW);
+						ImGui::BulletText("Height: %d", texH);
+					}
+					else {
+						ImGui::BulletText("Streaming... (placeholder)");
+					}
 				}
 
 				// Checker texture toggle
@@ -798,9 +1143,7 @@ void GUIElement::InspectorSetUp(bool* show)
 
 							// Load checker
 							string fullPath = Application::GetInstance().textures.get()->defaultTexDir;
-							string fileName = fullPath.substr(fullPath.find_last_of('/') + 1);
-							auto checkerTex = std::make_shared<Texture>();
-							checkerTex->TextureFromFile(fullPath, fileName.c_str());
+							TextureHandle checkerTex = Application::GetInstance().textures->cache->Acquire(fullPath, "texture_diffuse", false);
 
 							materialComp->SetDiffuseMap(checkerTex);
 						}
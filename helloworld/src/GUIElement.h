@@ -10,7 +10,7 @@
 #include "FileSystem.h"
 #include "GameObject.h"
 
-enum ElementType{ Additional, MenuBar, Console, Config, Hierarchy, Inspector,Asset};
+enum ElementType{ Additional, MenuBar, Console, Config, Hierarchy, Inspector,Asset, ProfilerPanel};
 
 class GUIElement {
 public:
@@ -22,11 +22,13 @@ public:
 	//type set ups
 	void MenuBarSetUp();
 	void AboutSetUp();
+	void RenderStatsSetUp();
 	void ConsoleSetUp(bool* show);
 	void ConfigSetUp(bool* show);
 	void HierarchySetUp(bool* show);
 	void InspectorSetUp(bool* show);
 	void AssetSetUp(bool* show);
+	void ProfilerSetUp(bool* show);
 
 	//other
 	void DrawNode(const std::shared_ptr<GameObject>& obj, std::shared_ptr<GameObject>& selected);
@@ -35,6 +37,8 @@ public:
 private:
 	ElementType type;
 	GUIManager* manager;
+	int profilerFrameAge = 0;	//0 = last finished frame
+	float profilerZoom = 1.0f;
 	void DrawDirectoryRecursive(const std::filesystem::path& dirPath);
 	void DrawFileNode(const std::string& path);
 };
\ No newline at end of file
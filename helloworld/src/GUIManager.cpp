@@ -12,6 +12,7 @@
 #include <imgui_impl_sdl3.h>
 #include <imgui_impl_opengl3.h>
 #include "Camera.h"
+#include "Headless.h"
 
 GUIManager::GUIManager() : Module(), AdditionalElements(ElementType::Additional, this), Menu(ElementType::MenuBar, this), sceneObjects(), selectedObject(nullptr)
 {
@@ -33,6 +34,10 @@ bool GUIManager::Awake()
 	WindowElements = LoadElements();
 	//AdditionalElements = GUIElement(ElementType::Additional);
 
+	//headless runs have no window to draw the editor in; io stays null and every call below is skipped
+	if (Application::GetInstance().headless->enabled)
+		return ret;
+
 	//Setup version
 	const char* glsl_version{ "#version 140" };
 	
@@ -70,6 +75,7 @@ std::vector<GUIElement> GUIManager::LoadElements()
 	elements.push_back(GUIElement(ElementType::Hierarchy, this));
 	elements.push_back(GUIElement(ElementType::Inspector, this));
 	elements.push_back(GUIElement(ElementType::Asset, this));
+	elements.push_back(GUIElement(ElementType::ProfilerPanel, this));
 
 	return elements;
 }
@@ -94,6 +100,9 @@ void GUIManager::AddGameObject(Model* obj) {
 
 bool GUIManager::Update(float dt)
 {
+	if (!io)
+		return true;
+
 	//initialize game object list
 
 	//if (!objectsInitialized) {
@@ -151,9 +160,6 @@ bool GUIManager::Update(float dt)
 		e.ElementSetUp();
 	}
 
-	//handle object deletion
-	for (auto& model : Application::GetInstance().openGL->modelObjects) model->CleanUpDestroyedObjects();
-
 	return true;
 }
 
@@ -202,32 +208,15 @@ Model* GUIManager::FindGameObjectModel(const std::shared_ptr<GameObject>& obj) {
 
 void GUIManager::AddToDeleteQueue(const std::shared_ptr<GameObject>& obj) {
 	if (obj) {
-		//find model that object belongs to
-		Model* ownerModel = FindGameObjectModel(obj);
-		if (ownerModel) {
-			//queue object for deletion
-			ownerModel->DestroyGameObject(obj);
-			LOG("Queued object %s for deletion.", obj.get()->GetName().c_str());
+		//queue object (and its children) for deletion, works for objects of any model
+		Application::GetInstance().openGL->destructionQueue->Enqueue(obj);
+		LOG("Queued object %s for deletion.", obj.get()->GetName().c_str());
 
-			//remove object from list so it doesnt display on the hierarchy
-			sceneObjects.erase(std::remove(sceneObjects.begin(), sceneObjects.end(), obj), sceneObjects.end());
-
-			//if object is still marked as the selected object -> selected is null
-			if (selectedObject == obj) selectedObject = nullptr;
-
-		}
-		else if (obj.get()->GetOwnerModel()) {
-			ownerModel = obj.get()->GetOwnerModel();
-			ownerModel->DestroyGameObject(obj);
-			LOG("Queued object %s for deletion.", obj.get()->GetName().c_str());
+		//remove object from list so it doesnt display on the hierarchy
+		sceneObjects.erase(std::remove(sceneObjects.begin(), sceneObjects.end(), obj), sceneObjects.end());
 
-			//remove object from list so it doesnt display on the hierarchy
-			sceneObjects.erase(std::remove(sceneObjects.begin(), sceneObjects.end(), obj), sceneObjects.end());
-
-			//if object is still marked as the selected object -> selected is null
-			if (selectedObject == obj) selectedObject = nullptr;
-		}
-		else LOG("Cannot delete Object %s- parent Model not found.", obj.get()->GetName().c_str());
+		//if object is still marked as the selected object -> selected is null
+		if (selectedObject == obj) selectedObject = nullptr;
 	}
 	else LOG("Attempting to delete null object.");
 }
@@ -259,11 +248,16 @@ void GUIManager::InitDock() {
 }
 
 void GUIManager::ProcessEvents(SDL_Event event) {
+	if (!io)
+		return;
 	ImGui_ImplSDL3_ProcessEvent(&event);
 }
 
 bool GUIManager::PostUpdate()
 {
+	if (!io)
+		return true;
+
 	//Render
 	ImGui::Render();
 
@@ -288,6 +282,9 @@ bool GUIManager::PostUpdate()
 //Called before quit
 bool GUIManager::CleanUp()
 {
+	if (!io)
+		return true;
+
 	ImGui_ImplOpenGL3_Shutdown();
 	ImGui_ImplSDL3_Shutdown();
 
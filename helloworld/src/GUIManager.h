@@ -74,6 +74,8 @@ public:
 	bool showHierarchy = true;
 	bool showInspector = true;
 	bool showAssets = true;
+	bool showRenderStats = false;
+	bool showProfiler = false;
 
 	std::vector<std::shared_ptr<GameObject>> sceneObjects;
 	std::shared_ptr<GameObject> selectedObject;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.h"
+#include "ComponentPool.h"
 #include "TransformComponent.h"
 #include "Mesh.h"
 #include "Model.h"
@@ -25,6 +26,13 @@ public:
     void RemoveComponent(ComponentType type);
     int GetComponentCount() const { return Components.size(); }
 
+    // Typed lookup through the per-type pools: O(1), no dynamic_cast, no refcount.
+    // The pointer stays valid while the component is attached
+    template<typename T> T* GetComponent() const { return ComponentPool<T>::Get().Find(id); }
+
+    // Index into the component pools, reused after the GameObject is destroyed
+    uint32_t GetId() const { return id; }
+
     // Parent/child management
     void SetParent(std::shared_ptr<GameObject> newParent);
     std::shared_ptr<GameObject> GetParent() const;
@@ -59,6 +67,10 @@ public:
 
 
 private:
+    void RegisterComponent(Component* component);
+    void UnregisterComponent(ComponentType type);
+
+    uint32_t id;
     std::string name;
     bool active = true;
     bool markedForDestroy = false;
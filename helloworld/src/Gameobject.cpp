@@ -5,13 +5,29 @@
 #include <algorithm>
 #include "Log.h"
 #include "CameraComponent.h"
+#include "PoolAllocator.h"
+
+// Ids index the component pools, so they are recycled to keep the pools small
+static std::vector<uint32_t> freeIds;
+static uint32_t nextId = 0;
 
 GameObject::GameObject(const std::string& name_)
     : name(name_), active(true) {
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+    }
+    else {
+        id = nextId++;
+    }
 }
 
 // No manual deletion needed; shared_ptr cleans up automatically
 GameObject::~GameObject() {
+    for (auto& comp : Components)
+        if (comp) UnregisterComponent(comp->GetType());
+    freeIds.push_back(id);
+
     Components.clear();
     children.clear();
 }
@@ -32,19 +48,19 @@ std::shared_ptr<Component> GameObject::AddComponent(ComponentType type) {
 
     switch (type) {
     case ComponentType::TRANSFORM:
-        newComponent = std::make_shared<TransformComponent>(shared_from_this());
+        newComponent = MakePooled<TransformComponent>(shared_from_this());
         LOG("Added TRANSFORM component to GameObject '%s'", name.c_str());
         break;
     case ComponentType::MESH_RENDERER:
-        newComponent = std::make_shared<RenderMeshComponent>(shared_from_this());
+        newComponent = MakePooled<RenderMeshComponent>(shared_from_this());
         LOG("Added MESH_RENDERER component to GameObject '%s'", name.c_str());
         break;
     case ComponentType::MATERIAL:
-        newComponent = std::make_shared<MaterialComponent>(shared_from_this());
+        newComponent = MakePooled<MaterialComponent>(shared_from_this());
         LOG("Added MATERIAL component to GameObject '%s'", name.c_str());
         break;
     case ComponentType::CAMERA:
-        newComponent = std::make_shared<CameraComponent>(shared_from_this());
+        newComponent = MakePooled<CameraComponent>(shared_from_this());
         LOG("Added CAMERA component to GameObject '%s'", name.c_str());
         break;
         //
@@ -53,12 +69,43 @@ std::shared_ptr<Component> GameObject::AddComponent(ComponentType type) {
         return nullptr;
     }
 
-    if (newComponent)
+    if (newComponent) {
         Components.push_back(newComponent);
+        RegisterComponent(newComponent.get());
+    }
 
     return newComponent;
 }
 
+void GameObject::RegisterComponent(Component* component) {
+    switch (component->GetType()) {
+    case ComponentType::TRANSFORM:
+        ComponentPool<TransformComponent>::Get().Add(id, static_cast<TransformComponent*>(component));
+        break;
+    case ComponentType::MESH_RENDERER:
+        ComponentPool<RenderMeshComponent>::Get().Add(id, static_cast<RenderMeshComponent*>(component));
+        break;
+    case ComponentType::MATERIAL:
+        ComponentPool<MaterialComponent>::Get().Add(id, static_cast<MaterialComponent*>(component));
+        break;
+    case ComponentType::CAMERA:
+        ComponentPool<CameraComponent>::Get().Add(id, static_cast<CameraComponent*>(component));
+        break;
+    default:
+        break;
+    }
+}
+
+void GameObject::UnregisterComponent(ComponentType type) {
+    switch (type) {
+    case ComponentType::TRANSFORM:      ComponentPool<TransformComponent>::Get().Remove(id); break;
+    case ComponentType::MESH_RENDERER:  ComponentPool<RenderMeshComponent>::Get().Remove(id); break;
+    case ComponentType::MATERIAL:       ComponentPool<MaterialComponent>::Get().Remove(id); break;
+    case ComponentType::CAMERA:         ComponentPool<CameraComponent>::Get().Remove(id); break;
+    default: break;
+    }
+}
+
 std::shared_ptr<Component> GameObject::GetComponent(ComponentType type) {
     for (auto& comp : Components) {
         if (comp && comp->GetType() == type)
@@ -68,6 +115,7 @@ std::shared_ptr<Component> GameObject::GetComponent(ComponentType type) {
 }
 
 void GameObject::RemoveComponent(ComponentType type) {
+    UnregisterComponent(type);
     auto it = std::remove_if(Components.begin(), Components.end(),
         [type](const std::shared_ptr<Component>& comp) {
             return comp && comp->GetType() == type;
@@ -99,6 +147,9 @@ void GameObject::SetParent(std::shared_ptr<GameObject> newParent) {
     if (newParent) {
         newParent->AddChild(shared_from_this());
     }
+
+    if (auto transform = GetComponent<TransformComponent>())
+        transform->SyncParent();
 }
 
 void GameObject::AddChild(std::shared_ptr<GameObject> child) {
@@ -111,6 +162,9 @@ void GameObject::AddChild(std::shared_ptr<GameObject> child) {
     children.push_back(child);
     child->parent = shared_from_this();
 
+    if (auto transform = child->GetComponent<TransformComponent>())
+        transform->SyncParent();
+
     LOG("Added child '%s' to '%s' (Total children: %zu)",
         child->GetName().c_str(),
         name.c_str(),
@@ -125,6 +179,8 @@ void GameObject::RemoveChild(std::shared_ptr<GameObject> child) {
         /*(*it)->parent.reset();
         children.erase(it, children.end());*/
         (*it)->parent.reset();   
+        if (auto transform = (*it)->GetComponent<TransformComponent>())
+            transform->SyncParent();
         children.erase(it);
     }
 }
@@ -0,0 +1,268 @@
+#include "Headless.h"
+#include "Application.h"
+#include "Camera.h"
+#include "Log.h"
+#include "SystemInfo.h"
+#include "ShaderManager.h"
+#include <SDL3_image/SDL_image.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <glm/gtc/constants.hpp>
+
+using Clock = std::chrono::steady_clock;
+
+Headless::Headless() : Module()
+{
+    name = "headless";
+}
+
+bool Headless::ParseArguments(int argc, char* argv[])
+{
+    auto usage = []() {
+        LOG("Usage: VroomEngine --headless [--frames N] [--warmup N] [--size WxH] [--dump DIR] [--dump-every N] [--report FILE]");
+        return false;
+    };
+
+    // Without --headless the arguments are not ours (a file opened with the editor,
+    // debugger launch settings...): the editor starts as usual
+    bool requested = false;
+    for (int i = 1; i < argc; i++)
+        requested = requested || std::string(argv[i]) == "--headless";
+    if (!requested)
+        return true;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (argument == "--headless") {
+            enabled = true;
+        }
+        else if (argument == "--frames" && hasValue) {
+            frames = std::atoi(argv[++i]);
+        }
+        else if (argument == "--warmup" && hasValue) {
+            warmupFrames = std::atoi(argv[++i]);
+        }
+        else if (argument == "--size" && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &width, &height) != 2)
+                return usage();
+        }
+        else if (argument == "--dump" && hasValue) {
+            dumpDir = argv[++i];
+        }
+        else if (argument == "--dump-every" && hasValue) {
+            dumpEvery = std::atoi(argv[++i]);
+        }
+        else if (argument == "--report" && hasValue) {
+            reportPath = argv[++i];
+        }
+        else {
+            LOG("Unknown argument '%s'", argument.c_str());
+            return usage();
+        }
+    }
+
+    if (frames <= 0 || warmupFrames < 0 || width <= 0 || height <= 0)
+        return usage();
+
+    // measure what the frame costs, not the limiter (no swap, so no vsync either)
+    Application::GetInstance().clock.targetFps = 0;
+    // no file scan jobs in the timed frames, and no program swapped mid-run
+    ShaderManager::GetInstance().hotReload = false;
+    LOG("Headless run: %d frames (%d warm-up) at %dx%d", frames, warmupFrames, width, height);
+    return true;
+}
+
+bool Headless::CreateFramebuffer()
+{
+    glGenRenderbuffers(1, &colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        LOG("Headless: framebuffer %dx%d incomplete", width, height);
+        return false;
+    }
+
+    // stays bound for the whole run: every draw lands here instead of the window
+    glViewport(0, 0, width, height);
+
+    const GLubyte* renderer = glGetString(GL_RENDERER);
+    const GLubyte* version = glGetString(GL_VERSION);
+    LOG("Headless: rendering offscreen on %s (%s)", renderer ? (const char*)renderer : "?", version ? (const char*)version : "?");
+    return true;
+}
+
+// One turn around orbitCenter over the whole run, looking at it
+void Headless::MoveCamera()
+{
+    Camera& camera = *Application::GetInstance().camera;
+
+    float angle = 2.0f * glm::pi<float>() * (float)frame / (float)frames;
+    glm::vec3 position = orbitCenter + glm::vec3(std::cos(angle) * orbitRadius, orbitHeight, std::sin(angle) * orbitRadius);
+    glm::vec3 direction = glm::normalize(orbitCenter - position);
+
+    // Camera::Update rebuilds the front vector and the matrices from these
+    camera.cameraPos = position;
+    camera.targetPos = orbitCenter;
+    camera.distance = glm::length(orbitCenter - position);
+    camera.yaw = glm::degrees(std::atan2(direction.z, direction.x));
+    camera.pitch = glm::degrees(std::asin(direction.y));
+}
+
+bool Headless::PreUpdate()
+{
+    if (!enabled)
+        return true;
+
+    if (framebuffer == 0 && !CreateFramebuffer()) {
+        failed = true;
+        return false;
+    }
+
+    MoveCamera();
+    frameStart = Clock::now();
+    return true;
+}
+
+// First module, so this runs once the scene was drawn (OpenGL::Update) and
+// before anything else of the frame. Application::FinishUpdate comes later and
+// is not timed: with pipelined frames the extraction kicked to a worker (and
+// the wait for it) is left out, only its overlap with the submission counts
+bool Headless::PostUpdate()
+{
+    if (!enabled)
+        return true;
+
+    // wait for the GPU (or llvmpipe) too, otherwise only the command submission is timed
+    glFinish();
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count();
+    if (frame >= warmupFrames)
+        frameMs.push_back(ms);
+
+    bool last = frame + 1 >= frames;
+    if (!dumpDir.empty() && (last || (dumpEvery > 0 && frame % dumpEvery == 0))) {
+        char fileName[32];
+        std::snprintf(fileName, sizeof(fileName), "frame_%05d.png", frame);
+        if (!DumpFrame(dumpDir + "/" + fileName)) {
+            failed = true;
+            return false;
+        }
+    }
+
+    frame++;
+    if (last) {
+        FinishRun();
+        Application::GetInstance().requestExit = true;
+    }
+    return true;
+}
+
+bool Headless::DumpFrame(const std::string& path)
+{
+    std::error_code error;
+    std::filesystem::create_directories(dumpDir, error);
+
+    std::vector<uint8_t> pixels((size_t)width * height * 4);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+    // GL rows go bottom to top, PNG rows top to bottom
+    size_t stride = (size_t)width * 4;
+    for (int y = 0; y < height / 2; y++)
+        std::swap_ranges(pixels.begin() + y * stride, pixels.begin() + (y + 1) * stride, pixels.begin() + (height - 1 - y) * stride);
+
+    SDL_Surface* surface = SDL_CreateSurfaceFrom(width, height, SDL_PIXELFORMAT_RGBA32, pixels.data(), (int)stride);
+    bool saved = surface && IMG_SavePNG(surface, path.c_str());
+    SDL_DestroySurface(surface);
+
+    if (!saved)
+        LOG("Headless: could not write %s: %s", path.c_str(), SDL_GetError());
+    return saved;
+}
+
+void Headless::FinishRun()
+{
+    report = Report();
+    report.frames = (uint32_t)frameMs.size();
+    if (frameMs.empty()) {
+        LOG("Headless: no frames measured (%d frames, %d warm-up)", frames, warmupFrames);
+        return;
+    }
+
+    std::vector<double> sorted = frameMs;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](double p) {
+        size_t index = (size_t)std::ceil(p * sorted.size());
+        return sorted[std::min(sorted.size() - 1, index > 0 ? index - 1 : 0)];
+    };
+
+    double total = 0.0;
+    for (double ms : sorted)
+        total += ms;
+
+    report.minMs = sorted.front();
+    report.maxMs = sorted.back();
+    report.avgMs = total / sorted.size();
+    report.p50Ms = percentile(0.50);
+    report.p95Ms = percentile(0.95);
+    report.p99Ms = percentile(0.99);
+    report.fps = report.avgMs > 0.0 ? 1000.0 / report.avgMs : 0.0;
+
+    LOG("Headless: %u frames, avg %.3f ms (%.1f fps), min %.3f, p50 %.3f, p95 %.3f, p99 %.3f, max %.3f ms",
+        report.frames, report.avgMs, report.fps, report.minMs, report.p50Ms, report.p95Ms, report.p99Ms, report.maxMs);
+
+    if (reportPath.empty())
+        return;
+
+    const GLubyte* renderer = glGetString(GL_RENDERER);
+    nlohmann::json json = {
+        { "frames", report.frames },
+        { "warmupFrames", warmupFrames },
+        { "width", width },
+        { "height", height },
+        { "renderer", renderer ? (const char*)renderer : "" },
+        { "cpuCores", GetCPUCoreCount() },
+        { "memoryMB", GetMemoryUsageMB() },
+        { "ms", {
+            { "min", report.minMs }, { "avg", report.avgMs }, { "p50", report.p50Ms },
+            { "p95", report.p95Ms }, { "p99", report.p99Ms }, { "max", report.maxMs } } },
+        { "fps", report.fps },
+        { "timed", "PreUpdate to PostUpdate + glFinish, without FinishUpdate (pipelined extraction wait, destruction queue)" },
+        { "frameMs", frameMs }
+    };
+
+    std::ofstream file(reportPath);
+    if (!file.is_open()) {
+        LOG("Headless: could not write %s", reportPath.c_str());
+        failed = true;
+        return;
+    }
+    file << json.dump(2);
+    LOG("Headless: report written to %s", reportPath.c_str());
+}
+
+bool Headless::CleanUp()
+{
+    if (framebuffer) glDeleteFramebuffers(1, &framebuffer);
+    if (colorBuffer) glDeleteRenderbuffers(1, &colorBuffer);
+    if (depthBuffer) glDeleteRenderbuffers(1, &depthBuffer);
+    framebuffer = colorBuffer = depthBuffer = 0;
+    return true;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "Module.h"
+#include <string>
+#include <vector>
+#include <chrono>
+
+// Offscreen run for CI and benchmarks, started with --headless.
+//
+// Window asks SDL for its "offscreen" video driver: no display server, the GL
+// context comes from EGL (Mesa's llvmpipe rasterizer on a box without GPU).
+// ImGui and the SDL renderer are not created and the buffers are never
+// swapped. The scene is drawn into a framebuffer object of the requested size
+// instead of the window.
+//
+// Every frame the editor camera follows a scripted orbit that depends only on
+// the frame number, so two runs render the same images. The frame can be
+// written to PNG every dumpEvery frames. After the last frame the frame time
+// statistics are logged (and written as JSON with --report) and the engine
+// exits. A frame is timed from PreUpdate to PostUpdate (after glFinish), so
+// Application::FinishUpdate, where the pipelined extraction is joined, is not
+// part of it.
+//
+//   VroomEngine --headless [--frames N] [--warmup N] [--size WxH]
+//               [--dump DIR] [--dump-every N] [--report FILE]
+class Headless : public Module {
+public:
+
+    struct Report {
+        uint32_t frames = 0;          // measured, warm-up frames left out
+        double minMs = 0.0;
+        double avgMs = 0.0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+        double fps = 0.0;             // from avgMs
+    };
+
+    Headless();
+
+    // Called from main before Awake. Without --headless the arguments are ignored;
+    // with it, false on an unknown or malformed one (the usage is logged)
+    bool ParseArguments(int argc, char* argv[]);
+
+    bool PreUpdate() override;
+    bool PostUpdate() override;
+    bool CleanUp() override;
+
+    bool enabled = false;
+    int frames = 300;
+    int warmupFrames = 10;            // first frames left out of the statistics (loading, shader cache...)
+    int width = 1280;
+    int height = 720;
+    std::string dumpDir;              // empty = no PNGs
+    int dumpEvery = 60;               // the last frame is always written
+    std::string reportPath;           // JSON, empty = log only
+    bool failed = false;              // no framebuffer, or a dump or the report could not be written: main exits with an error
+
+    // Orbit of the scripted camera
+    glm::vec3 orbitCenter = glm::vec3(0.0f, 1.0f, 0.0f);
+    float orbitRadius = 15.0f;
+    float orbitHeight = 5.0f;
+
+    const Report& GetReport() const { return report; }
+
+private:
+    bool CreateFramebuffer();
+    void MoveCamera();
+    bool DumpFrame(const std::string& path);
+    void FinishRun();
+
+    GLuint framebuffer = 0;
+    GLuint colorBuffer = 0;
+    GLuint depthBuffer = 0;
+
+    int frame = 0;
+    std::chrono::steady_clock::time_point frameStart;
+    std::vector<double> frameMs;
+    Report report;
+};
@@ -224,9 +224,7 @@ void Input::ProcessDroppedFile(std::string sourcePath) {
 			return;
 		}
 
-		auto meshComp = std::dynamic_pointer_cast<RenderMeshComponent>(
-			selectedObj->GetComponent(ComponentType::MESH_RENDERER)
-		);
+		auto meshComp = selectedObj->GetComponent<RenderMeshComponent>();
 
 		if (!meshComp) {
 			LOG("You selected an empty GameObject. Select a GameObject from the hierarchy with a mesh and try again");
@@ -234,16 +232,12 @@ void Input::ProcessDroppedFile(std::string sourcePath) {
 		}
 
 		// Get MaterialComponent
-		auto materialComp = std::dynamic_pointer_cast<MaterialComponent>(
-			selectedObj->GetComponent(ComponentType::MATERIAL)
-		);
+		auto materialComp = selectedObj->GetComponent<MaterialComponent>();
 
 		if (!materialComp) {
 			LOG("No MaterialComponent found, creating one");
 			selectedObj->AddComponent(ComponentType::MATERIAL);
-			materialComp = std::dynamic_pointer_cast<MaterialComponent>(
-				selectedObj->GetComponent(ComponentType::MATERIAL)
-			);
+			materialComp = selectedObj->GetComponent<MaterialComponent>();
 		}
 
 		if (!materialComp) {
@@ -253,17 +247,14 @@ void Input::ProcessDroppedFile(std::string sourcePath) {
 
 		// Load the dropped texture
 		string fileName = sourcePath.substr(sourcePath.find_last_of('/') + 1);
-		auto droppedTex = std::make_shared<Texture>();
-		bool success = droppedTex->TextureFromFile(sourcePath, fileName.c_str());
+		// Cached by path: dropping the same file twice reuses the GPU texture
+		TextureHandle droppedTex = Application::GetInstance().textures->cache->Acquire(sourcePath, "texture_diffuse", false);
 
-		if (!success || droppedTex->id == 0) {
+		if (!droppedTex || droppedTex.GetId() == 0) {
 			LOG("ERROR: Failed to load texture: %s", sourcePath.c_str());
 			return;
 		}
 
-		droppedTex->mapType = "texture_diffuse";
-		droppedTex->path = sourcePath;
-
 		// Set it on the MaterialComponent
 		materialComp->SetDiffuseMap(droppedTex);
 
@@ -272,7 +263,7 @@ void Input::ProcessDroppedFile(std::string sourcePath) {
 		if (meshPtr) {
 			// Clear old textures and add new one
 			meshPtr->textures.clear();
-			meshPtr->textures.push_back(*droppedTex);
+			meshPtr->textures.push_back(droppedTex);
 		}
 
 		// KEY FIX: Update the parent model's savedTexture
@@ -284,17 +275,14 @@ void Input::ProcessDroppedFile(std::string sourcePath) {
 			// Also update originalTextures map if it exists
 			if (meshPtr && parentModel->originalTextures.find(meshPtr) != parentModel->originalTextures.end()) {
 				parentModel->originalTextures[meshPtr].clear();
-				parentModel->originalTextures[meshPtr].push_back(*droppedTex);
+				parentModel->originalTextures[meshPtr].push_back(droppedTex);
 			}
 		}
 
 		LOG("Texture '%s' (ID: %d) applied to '%s'",
 			fileName.c_str(),
-			droppedTex->id,
+			droppedTex.GetId(),
 			selectedObj->GetName().c_str());
-
-		// Add to global texture cache
-		Application::GetInstance().textures.get()->textures_loaded.push_back(*droppedTex);
 	}
 	
 }
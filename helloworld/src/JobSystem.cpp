@@ -0,0 +1,325 @@
+#include "JobSystem.h"
+#include "Log.h"
+#include <chrono>
+#include <cmath>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    // which JobSystem the current thread works for (benchmarks run several at once)
+    thread_local const JobSystem* currentSystem = nullptr;
+    thread_local size_t currentSlot = 0;
+}
+
+JobSystem::JobSystem(int workerCount) {
+    if (workerCount < 0) {
+        unsigned int hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? (int)hardware - 1 : 0;
+    }
+
+    for (int i = 0; i <= workerCount; ++i)
+        queues.push_back(std::make_unique<Queue>());
+
+    workers.reserve(workerCount);
+    for (int i = 0; i < workerCount; ++i)
+        workers.emplace_back(&JobSystem::WorkerLoop, this, (size_t)i);
+}
+
+JobSystem::~JobSystem() {
+    Shutdown();
+}
+
+void JobSystem::Shutdown() {
+    if (workers.empty())
+        return;
+
+    // nobody may be left waiting on a job that will never run
+    while (RunOne()) {}
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        quit = true;
+    }
+    sleepCondition.notify_all();
+
+    for (auto& worker : workers)
+        worker.join();
+    workers.clear();
+
+    while (RunOne()) {}
+}
+
+size_t JobSystem::CurrentSlot() const {
+    return currentSystem == this ? currentSlot : queues.size() - 1;
+}
+
+void JobSystem::Run(Job job, Counter* counter) {
+    if (counter)
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    Push({ std::move(job), counter });
+}
+
+void JobSystem::RunAfter(Counter& dependency, Job job, Counter* counter) {
+    if (counter)
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        // Execute() drops the count to zero and then always takes this lock to
+        // look for continuations. So either the dependency is already done here,
+        // or this insert happens before that lookup and is found there
+        std::lock_guard<std::mutex> lock(continuationMutex);
+        if (!dependency.IsDone()) {
+            continuations.push_back({ &dependency, { std::move(job), counter } });
+            return;
+        }
+    }
+    Push({ std::move(job), counter });
+}
+
+void JobSystem::Wait(Counter& counter) {
+    while (!counter.IsDone()) {
+        if (!RunOne())
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::Push(Task task) {
+    size_t slot = CurrentSlot();
+    {
+        std::lock_guard<std::mutex> lock(queues[slot]->mutex);
+        queues[slot]->tasks.push_back(std::move(task));
+    }
+    queued.fetch_add(1, std::memory_order_release);
+
+    if (!workers.empty()) {
+        // a worker between its check and the wait would miss the notify otherwise
+        { std::lock_guard<std::mutex> lock(sleepMutex); }
+        sleepCondition.notify_one();
+    }
+}
+
+bool JobSystem::Pop(size_t slot, bool fromBack, Task& task) {
+    Queue& queue = *queues[slot];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+        return false;
+
+    if (fromBack) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+    }
+    else {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+    }
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool JobSystem::RunOne() {
+    if (queued.load(std::memory_order_acquire) <= 0)
+        return false;
+
+    size_t own = CurrentSlot();
+    size_t shared = queues.size() - 1;
+    Task task;
+
+    // own work newest first, then the shared queue, then steal the oldest from the others
+    bool found = Pop(own, true, task);
+    if (!found && own != shared)
+        found = Pop(shared, false, task);
+    if (!found) {
+        for (size_t i = 1; i < queues.size() && !found; ++i) {
+            size_t victim = (own + i) % queues.size();
+            if (victim == shared)
+                continue;
+            found = Pop(victim, false, task);
+            if (found)
+                stolen.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    if (!found)
+        return false;
+
+    Execute(task);
+    return true;
+}
+
+void JobSystem::Execute(Task& task) {
+    task.job();
+    task.job = nullptr;
+    executed.fetch_add(1, std::memory_order_relaxed);
+
+    Counter* counter = task.counter;
+    if (!counter || counter->pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    // counter reached zero. It may already be gone (its waiter returned), so
+    // from here on it is only compared, never dereferenced. No lock free "no
+    // continuations" shortcut: RunAfter may be between its IsDone check and
+    // its insert, and only this lock orders the two
+    std::vector<Task> ready;
+    {
+        std::lock_guard<std::mutex> lock(continuationMutex);
+        for (size_t i = 0; i < continuations.size();) {
+            if (continuations[i].dependency == counter) {
+                ready.push_back(std::move(continuations[i].task));
+                continuations[i] = std::move(continuations.back());
+                continuations.pop_back();
+            }
+            else {
+                ++i;
+            }
+        }
+    }
+
+    for (auto& next : ready)
+        Push(std::move(next));
+}
+
+void JobSystem::WorkerLoop(size_t slot) {
+    currentSystem = this;
+    currentSlot = slot;
+
+    while (true) {
+        if (RunOne())
+            continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepCondition.wait(lock, [this] { return quit || queued.load(std::memory_order_acquire) > 0; });
+        if (quit)
+            return;
+    }
+}
+
+std::vector<JobSystem::ScalingResult> JobSystem::BenchmarkScaling(size_t items) {
+    std::vector<ScalingResult> results;
+    std::vector<float> output(items);
+
+    // enough math per item that scheduling overhead doesn't dominate
+    auto work = [&output](size_t i) {
+        float x = (float)i * 0.001f;
+        for (int k = 0; k < 64; ++k)
+            x = std::sin(x) * 0.5f + std::sqrt(x * x + 1.0f);
+        output[i] = x;
+    };
+
+    // 1, 2, 3, 4, 8, 16... and always the real thread count
+    unsigned int hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned int> threadCounts;
+    for (unsigned int threads = 1; threads <= hardware; threads = threads < 4 ? threads + 1 : threads * 2)
+        threadCounts.push_back(threads);
+    if (threadCounts.back() != hardware)
+        threadCounts.push_back(hardware);
+
+    for (unsigned int threads : threadCounts) {
+        JobSystem system((int)threads - 1);
+
+        auto start = Clock::now();
+        system.ParallelFor(items, work);
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        ScalingResult result;
+        result.threads = threads;
+        result.ms = ms;
+        result.speedup = results.empty() || ms <= 0.0 ? 1.0 : results.front().ms / ms;
+        results.push_back(result);
+
+        LOG("JobSystem benchmark: %u thread(s) %.2f ms (x%.2f)", threads, ms, result.speedup);
+    }
+
+    return results;
+}
+
+JobSystem::StressResult JobSystem::StressTest() {
+    StressResult result;
+    auto start = Clock::now();
+    uint64_t executedBefore = executed.load();
+
+    // 1. lots of tiny jobs on a single counter
+    {
+        const int count = 100000;
+        std::atomic<int> sum{ 0 };
+        Counter counter;
+        for (int i = 0; i < count; ++i)
+            Run([&sum] { sum.fetch_add(1, std::memory_order_relaxed); }, &counter);
+        Wait(counter);
+        if (sum.load() != count)
+            result.failure = "flat jobs: " + std::to_string(sum.load()) + " of " + std::to_string(count);
+    }
+
+    // 2. jobs that spawn children and wait for them from inside a worker
+    if (result.failure.empty()) {
+        const int parents = 64;
+        const int children = 64;
+        std::atomic<int> sum{ 0 };
+        Counter counter;
+        for (int p = 0; p < parents; ++p) {
+            Run([this, &sum] {
+                Counter inner;
+                for (int c = 0; c < children; ++c)
+                    Run([&sum] { sum.fetch_add(1, std::memory_order_relaxed); }, &inner);
+                Wait(inner);
+            }, &counter);
+        }
+        Wait(counter);
+        if (sum.load() != parents * children)
+            result.failure = "nested jobs: " + std::to_string(sum.load()) + " of " + std::to_string(parents * children);
+    }
+
+    // 3. dependency chains: each stage only starts once the previous one is done
+    if (result.failure.empty()) {
+        const int chains = 16;
+        const int stages = 256;
+        std::vector<Counter> counters(chains * stages);
+        std::vector<int> progress(chains, 0);
+        std::atomic<int> outOfOrder{ 0 };
+
+        for (int c = 0; c < chains; ++c) {
+            for (int s = 0; s < stages; ++s) {
+                auto stage = [&progress, &outOfOrder, c, s] {
+                    if (progress[c] != s) outOfOrder.fetch_add(1);
+                    progress[c] = s + 1;
+                };
+                Counter* counter = &counters[c * stages + s];
+                if (s == 0)
+                    Run(stage, counter);
+                else
+                    RunAfter(counters[c * stages + s - 1], stage, counter);
+            }
+        }
+        for (int c = 0; c < chains; ++c)
+            Wait(counters[c * stages + stages - 1]);
+
+        for (int c = 0; c < chains && result.failure.empty(); ++c)
+            if (progress[c] != stages)
+                result.failure = "chain " + std::to_string(c) + " stopped at " + std::to_string(progress[c]);
+        if (result.failure.empty() && outOfOrder.load() != 0)
+            result.failure = std::to_string(outOfOrder.load()) + " stage(s) ran before their dependency";
+    }
+
+    // 4. ParallelFor covers every index exactly once
+    if (result.failure.empty()) {
+        std::vector<std::atomic<int>> hits(50000);
+        for (auto& hit : hits) hit.store(0);
+        ParallelFor(hits.size(), [&hits](size_t i) { hits[i].fetch_add(1, std::memory_order_relaxed); }, 7);
+        for (size_t i = 0; i < hits.size(); ++i) {
+            if (hits[i].load() != 1) {
+                result.failure = "ParallelFor index " + std::to_string(i) + " ran " + std::to_string(hits[i].load()) + " time(s)";
+                break;
+            }
+        }
+    }
+
+    result.passed = result.failure.empty();
+    result.jobs = executed.load() - executedBefore;
+    result.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    if (result.passed)
+        LOG("JobSystem stress test passed: %llu jobs on %u worker(s) in %.2f ms", (unsigned long long)result.jobs, GetWorkerCount(), result.ms);
+    else
+        LOG("JobSystem stress test FAILED: %s", result.failure.c_str());
+
+    return result;
+}
@@ -0,0 +1,158 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+
+// Work-stealing job scheduler shared by every module (Application::jobs).
+//
+// Each worker owns a deque: it pushes and pops its own jobs at the back
+// (newest first, still hot in cache) and, when it runs dry, steals the
+// oldest job from the front of another worker's deque. Jobs pushed from
+// threads that are not workers (main thread, streamer threads) go to a
+// shared queue every worker also takes from.
+//
+// Jobs are grouped with a Counter: Run(job, &counter) adds one to it and
+// the job removes it when done. Wait(counter) doesn't just block, the
+// waiting thread runs pending jobs meanwhile, so waiting inside a job is
+// fine. RunAfter() starts a job only once another counter reaches zero.
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    // Unfinished jobs of a group. Must outlive the jobs counted on it
+    class Counter {
+    public:
+        bool IsDone() const { return pending.load(std::memory_order_acquire) == 0; }
+    private:
+        friend class JobSystem;
+        std::atomic<int> pending{ 0 };
+    };
+
+    struct Stats {
+        uint64_t executed = 0;
+        uint64_t stolen = 0;
+    };
+
+    // workerCount < 0 = hardware threads - 1 (the main thread is the remaining one)
+    explicit JobSystem(int workerCount = -1);
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void Run(Job job, Counter* counter = nullptr);
+    // job starts when dependency is done (right away if it already is)
+    void RunAfter(Counter& dependency, Job job, Counter* counter = nullptr);
+    // Runs other jobs until counter reaches zero
+    void Wait(Counter& counter);
+
+    // body(i) for every i in [0, count), in chunks of grain items (0 = about 4 chunks
+    // per thread). Blocks until done; returns how many threads took part
+    template<typename Body>
+    unsigned int ParallelFor(size_t count, Body&& body, size_t grain = 0);
+
+    unsigned int GetWorkerCount() const { return (unsigned int)workers.size(); }
+    Stats GetStats() const { return { executed.load(), stolen.load() }; }
+    // Joins the workers. Pending jobs are run first
+    void Shutdown();
+
+    // Scaling benchmark: the same CPU bound ParallelFor with 0, 1, 2... workers
+    struct ScalingResult {
+        unsigned int threads = 0;     // workers + the calling thread
+        double ms = 0.0;
+        double speedup = 1.0;         // against threads = 1
+    };
+    static std::vector<ScalingResult> BenchmarkScaling(size_t items = 1 << 18);
+
+    // Many tiny jobs, nested waits inside jobs and dependency chains, results checked
+    struct StressResult {
+        bool passed = false;
+        uint64_t jobs = 0;
+        double ms = 0.0;
+        std::string failure;
+    };
+    StressResult StressTest();
+
+    std::vector<ScalingResult> lastScaling;
+    StressResult lastStress;
+
+private:
+
+    struct Task {
+        Job job;
+        Counter* counter = nullptr;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    struct Continuation {
+        Counter* dependency;
+        Task task;
+    };
+
+    void Push(Task task);
+    bool RunOne();
+    bool Pop(size_t slot, bool fromBack, Task& task);
+    void Execute(Task& task);
+    void WorkerLoop(size_t slot);
+    // Slot of the calling thread: its own queue for workers, the shared one otherwise
+    size_t CurrentSlot() const;
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<Queue>> queues;   // one per worker + the shared one (last)
+    std::atomic<int> queued{ 0 };
+    std::atomic<bool> quit{ false };
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+
+    std::mutex continuationMutex;
+    std::vector<Continuation> continuations;
+
+    std::atomic<uint64_t> executed{ 0 };
+    std::atomic<uint64_t> stolen{ 0 };
+};
+
+template<typename Body>
+unsigned int JobSystem::ParallelFor(size_t count, Body&& body, size_t grain) {
+    if (count == 0)
+        return 0;
+
+    size_t threads = workers.size() + 1;
+    if (grain == 0)
+        grain = std::max<size_t>(1, count / (threads * 4));
+    size_t chunks = (count + grain - 1) / grain;
+
+    if (chunks == 1 || workers.empty()) {
+        for (size_t i = 0; i < count; ++i) body(i);
+        return 1;
+    }
+
+    // one flag per slot; non worker threads all share the last one
+    std::vector<std::atomic<bool>> tookPart(queues.size());
+    for (auto& flag : tookPart) flag.store(false, std::memory_order_relaxed);
+    Counter counter;
+    for (size_t c = 0; c < chunks; ++c) {
+        Run([&, c]() {
+            size_t begin = c * grain;
+            size_t end = std::min(count, begin + grain);
+            for (size_t i = begin; i < end; ++i) body(i);
+            tookPart[CurrentSlot()].store(true, std::memory_order_relaxed);
+        }, &counter);
+    }
+    Wait(counter);
+
+    unsigned int threadsUsed = 0;
+    for (auto& flag : tookPart)
+        if (flag.load(std::memory_order_relaxed)) threadsUsed++;
+    return threadsUsed;
+}
@@ -10,8 +10,9 @@ static std::mutex g_LogMutex;
 
 void Log(const char file[], int line, const char* format, ...)
 {
-    static char tmpString1[4096];
-    static va_list ap;
+    // Local buffers: the importer logs from worker threads
+    char tmpString1[4096];
+    va_list ap;
 
     // Construct the string from variable arguments
     va_start(ap, format);
@@ -21,14 +22,14 @@ void Log(const char file[], int line, const char* format, ...)
     // Construct the final log message
     std::string logMessage = std::string("\n") + file + "(" + std::to_string(line) + ") : " + tmpString1;
 
-    // Print the formatted string to the standard error stream
-    std::cerr << logMessage << std::endl;
-
     //store logs in memory for imGui console
     //thread safe block - only one thread at a time
     {
         //threads wait until mutex is unlocked to add logs
         std::lock_guard<std::mutex> lock(g_LogMutex);
+
+        // Print the formatted string to the standard error stream (inside the lock so lines don't interleave)
+        std::cerr << logMessage << std::endl;
         g_LogBuffer.emplace_back(logMessage);
     }
 }
@@ -0,0 +1,36 @@
+#pragma once
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+// Read-only memory mapping of a whole file.
+// The mapped bytes stay valid until Close() or the destructor, so anything
+// pointing into GetData() must keep the MappedFile alive (see Mesh::Load).
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return data != nullptr; }
+    const uint8_t* GetData() const { return data; }
+    size_t GetSize() const { return size; }
+    const std::string& GetPath() const { return path; }
+
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    std::string path;
+
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fileDescriptor = -1;
+#endif
+};
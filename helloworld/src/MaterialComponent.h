@@ -3,6 +3,7 @@
 #include <glm/glm.hpp>
 #include <string>
 #include "Textures.h"
+#include "TextureCache.h"
 
 class MaterialComponent : public Component {
 public:
@@ -28,23 +29,23 @@ public:
     void SetRoughness(float rough) { roughness = rough; }
     float GetRoughness() const { return roughness; }
 
-    void SetDiffuseMap(std::shared_ptr<Texture> tex) { diffuseMap = tex; }
-    std::shared_ptr<Texture> GetDiffuseMap() const { return diffuseMap; }
+    void SetDiffuseMap(TextureHandle tex) { diffuseMap = tex; }
+    TextureHandle GetDiffuseMap() const { return diffuseMap; }
 
-    void SetNormalMap(std::shared_ptr<Texture> tex) { normalMap = tex; }
-    std::shared_ptr<Texture> GetNormalMap() const { return normalMap; }
+    void SetNormalMap(TextureHandle tex) { normalMap = tex; }
+    TextureHandle GetNormalMap() const { return normalMap; }
 
-    void SetSpecularMap(std::shared_ptr<Texture> tex) { specularMap = tex; }
-    std::shared_ptr<Texture> GetSpecularMap() const { return specularMap; }
+    void SetSpecularMap(TextureHandle tex) { specularMap = tex; }
+    TextureHandle GetSpecularMap() const { return specularMap; }
 
-    void SetMetallicMap(std::shared_ptr<Texture> tex) { metallicMap = tex; }
-    std::shared_ptr<Texture> GetMetallicMap() const { return metallicMap; }
+    void SetMetallicMap(TextureHandle tex) { metallicMap = tex; }
+    TextureHandle GetMetallicMap() const { return metallicMap; }
 
-    void SetRoughnessMap(std::shared_ptr<Texture> tex) { roughnessMap = tex; }
-    std::shared_ptr<Texture> GetRoughnessMap() const { return roughnessMap; }
+    void SetRoughnessMap(TextureHandle tex) { roughnessMap = tex; }
+    TextureHandle GetRoughnessMap() const { return roughnessMap; }
 
-    void SetAOMap(std::shared_ptr<Texture> tex) { aoMap = tex; }
-    std::shared_ptr<Texture> GetAOMap() const { return aoMap; }
+    void SetAOMap(TextureHandle tex) { aoMap = tex; }
+    TextureHandle GetAOMap() const { return aoMap; }
 
 private:
     // Material properties
@@ -60,12 +61,12 @@ private:
     
     /*Texture defaultColorTex;*/
     //can be null
-    std::shared_ptr<Texture> diffuseMap;
-    std::shared_ptr<Texture> specularMap;
-    std::shared_ptr<Texture> normalMap;
-    std::shared_ptr<Texture> metallicMap;
-    std::shared_ptr<Texture> roughnessMap;
-    std::shared_ptr<Texture> aoMap;
+    TextureHandle diffuseMap;
+    TextureHandle specularMap;
+    TextureHandle normalMap;
+    TextureHandle metallicMap;
+    TextureHandle roughnessMap;
+    TextureHandle aoMap;
 
    
 
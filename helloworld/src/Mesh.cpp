@@ -5,10 +5,20 @@
 #include "GuiManager.h"
 #include "Render.h"
 #include "Resource.h"
+#include "MappedFile.h"
+#include "MeshFormat.h"
+#include "ModelFormat.h"
 #include <fstream>
+#include "Profiler.h"
+#include "JobSystem.h"
+#include "RenderQueue.h"
+#include <cmath>
+
+// Triangles / vertices per job when generating normals
+static constexpr size_t NORMAL_GRAIN = 4096;
 
 // CORRECCIÓN: Se añade ": Resource(...)" para inicializar la clase base
-Mesh::Mesh(vector<Vertex> _vertices, vector<unsigned int> _indices, vector<Texture> _textures)
+Mesh::Mesh(vector<Vertex> _vertices, vector<unsigned int> _indices, vector<TextureHandle> _textures)
     : Resource(ResourceType::MESH, "Mesh")
 {
     this->vertices = _vertices;
@@ -18,15 +28,28 @@ Mesh::Mesh(vector<Vertex> _vertices, vector<unsigned int> _indices, vector<Textu
     drawVertNormals = false;
     drawFaceNormals = false;
 
+    // meshes built without normals (Assimp had none) leave them all at zero
+    hasSourceNormals = std::any_of(vertices.begin(), vertices.end(),
+        [](const Vertex& vertex) { return vertex.Normal != glm::vec3(0.0f); });
+
     this->setupMesh();
-    CalculateNormals();
     CalculateAABB();
+    triangleBVH.Build(GetVertexData(), GetIndexData(), GetIndexCount());
 }
 
 Mesh::~Mesh() {
 
 }
 
+void Mesh::ReleaseGPU() {
+    if (EBO) glDeleteBuffers(1, &EBO);
+    if (VBO) glDeleteBuffers(1, &VBO);
+    if (VAO) glDeleteVertexArrays(1, &VAO);
+    VAO = VBO = EBO = 0;
+    faceNormalLines.Release();
+    vertNormalLines.Release();
+}
+
 void Mesh::setupMesh() {
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
@@ -35,10 +58,11 @@ void Mesh::setupMesh() {
     glBindVertexArray(VAO);
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
 
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW); //send to OpenGL (GPU)
+    // for Library meshes these pointers are the mapped file itself, no intermediate copy
+    glBufferData(GL_ARRAY_BUFFER, GetVertexCount() * sizeof(Vertex), GetVertexData(), GL_STATIC_DRAW); //send to OpenGL (GPU)
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW); //send to GPU
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, GetIndexCount() * sizeof(unsigned int), GetIndexData(), GL_STATIC_DRAW); //send to GPU
 
     // vertex positions
     glEnableVertexAttribArray(0);
@@ -63,7 +87,9 @@ void Mesh::CalculateAABB() {
     meshAABB.max = glm::vec3(std::numeric_limits<float>::lowest());
 
     // Iterar sobre todos los vértices del mesh
-    for (const auto& vertex : vertices) {
+    const Vertex* vertexData = GetVertexData();
+    for (size_t i = 0; i < GetVertexCount(); i++) {
+        const Vertex& vertex = vertexData[i];
         // Actualizar min
         meshAABB.min.x = std::min(meshAABB.min.x, vertex.Position.x);
         meshAABB.min.y = std::min(meshAABB.min.y, vertex.Position.y);
@@ -76,232 +102,248 @@ void Mesh::CalculateAABB() {
     }
 }
 
-void Mesh::DrawAABB(Shader& shader, const glm::mat4& modelMatrix, const glm::vec4& color) {
-
-    // Cambiar a modo wireframe
-    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-
-    // Configurar la matriz del modelo (Transformación de World Space)
-    GLint modelLoc = glGetUniformLocation(shader.ID, "model");
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(modelMatrix));
-
-    // Configurar color para visualización
-    glUniform1i(glGetUniformLocation(shader.ID, "useLineColor"), true);
-    glUniform4f(glGetUniformLocation(shader.ID, "lineColor"), color.r, color.g, color.b, color.a);
-    glLineWidth(2.0f); // Puedes ajustar el ancho de línea
-
-    glm::vec3 min = meshAABB.min;
-    glm::vec3 max = meshAABB.max;
-
-    // Definir los 8 vértices del AABB
-    glm::vec3 v[8] = {
-        glm::vec3(min.x, min.y, min.z), // 0
-        glm::vec3(max.x, min.y, min.z), // 1
-        glm::vec3(min.x, max.y, min.z), // 2
-        glm::vec3(max.x, max.y, min.z), // 3
-        glm::vec3(min.x, min.y, max.z), // 4
-        glm::vec3(max.x, min.y, max.z), // 5
-        glm::vec3(min.x, max.y, max.z), // 6
-        glm::vec3(max.x, max.y, max.z)  // 7
-    };
-
-    // Dibujar las 12 aristas usando GL_LINES
-    glBegin(GL_LINES);
-    // Cara inferior
-    glVertex3fv(glm::value_ptr(v[0])); glVertex3fv(glm::value_ptr(v[1]));
-    glVertex3fv(glm::value_ptr(v[1])); glVertex3fv(glm::value_ptr(v[5]));
-    glVertex3fv(glm::value_ptr(v[5])); glVertex3fv(glm::value_ptr(v[4]));
-    glVertex3fv(glm::value_ptr(v[4])); glVertex3fv(glm::value_ptr(v[0]));
-
-    // Cara superior
-    glVertex3fv(glm::value_ptr(v[2])); glVertex3fv(glm::value_ptr(v[3]));
-    glVertex3fv(glm::value_ptr(v[3])); glVertex3fv(glm::value_ptr(v[7]));
-    glVertex3fv(glm::value_ptr(v[7])); glVertex3fv(glm::value_ptr(v[6]));
-    glVertex3fv(glm::value_ptr(v[6])); glVertex3fv(glm::value_ptr(v[2]));
-
-    // Conexiones verticales
-    glVertex3fv(glm::value_ptr(v[0])); glVertex3fv(glm::value_ptr(v[2]));
-    glVertex3fv(glm::value_ptr(v[1])); glVertex3fv(glm::value_ptr(v[3]));
-    glVertex3fv(glm::value_ptr(v[5])); glVertex3fv(glm::value_ptr(v[7]));
-    glVertex3fv(glm::value_ptr(v[4])); glVertex3fv(glm::value_ptr(v[6]));
-    glEnd();
-
-    // Resetear el color de línea y el modo de polígono a relleno
-    glUniform1i(glGetUniformLocation(shader.ID, "useLineColor"), false);
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-}
-
 void Mesh::Draw(Shader& shader) {
-    unsigned int diffuseNr = 1;
-    unsigned int specularNr = 1;
-    unsigned int normalNr = 1;
-    unsigned int roughnessNr = 1;
-    unsigned int metallicNr = 1;
-    unsigned int aoNr = 1;
-
-
-
-    for (unsigned int i = 0; i < textures.size(); i++)
-    {
-        glActiveTexture(GL_TEXTURE0 + i); // CORRECCIÓN: Activa una unidad diferente (0, 1, 2, ...)
-        // retrieve texture number (the N in diffuse_textureN)
-        string number;
-        string name = textures[i].mapType;
-
-        if (name == "texture_diffuse")
-            number = std::to_string(diffuseNr++);
-        else if (name == "texture_specular")
-            number = std::to_string(specularNr++);
-        // Añadir lógica para los nuevos tipos de mapa
-        else if (name == "texture_normal")
-            number = std::to_string(normalNr++);
-        else if (name == "texture_roughness")
-            number = std::to_string(roughnessNr++);
-        else if (name == "texture_metallic")
-            number = std::to_string(metallicNr++);
-        else if (name == "texture_ao")
-            number = std::to_string(aoNr++);
-
-
-        // Establece el uniform sampler en el shader. El valor 'i' es el índice de la unidad activa.
-        shader.setInt(("material." + name + number).c_str(), i);
-
-
-        glBindTexture(GL_TEXTURE_2D, textures[i].id);
-
-    }
-
-
-
-    if (drawFaceNormals) {
-
-
-        glUniform1i(glGetUniformLocation(shader.ID, "useLineColor"), true);
-        glUniform4f(glGetUniformLocation(shader.ID, "lineColor"), 0.0f, 1.0f, 0.0f, 1.0f); //green for vertex
-
-
-        glBegin(GL_LINES);
-
-
-        for (int i = 0; i < indices.size(); i += 3) {
-            glm::vec3 start = vertices[indices[i]].Position;
-            glm::vec3 end = start + normals[indices[i]] * 0.2f;
-            glVertex3fv(glm::value_ptr(start));
-            glVertex3fv(glm::value_ptr(end));
-        }
-
-        glEnd();
-        glUniform1i(glGetUniformLocation(shader.ID, "useLineColor"), false);
-    }
-
-    if (drawVertNormals) {
-
-
-        glUniform1i(glGetUniformLocation(shader.ID, "useLineColor"), true);
-        glUniform4f(glGetUniformLocation(shader.ID, "lineColor"), 0.0f, 0.9f, 1.0f, 1.0f); //blue for face
-
-        glBegin(GL_LINES);
-
-
-        for (int i = 0; i < vertices.size(); i += 3) {
-            glm::vec3 v0 = vertices[indices[i]].Position;
-            glm::vec3 v1 = vertices[indices[i + 1]].Position;
-            glm::vec3 v2 = vertices[indices[i + 2]].Position;
-
-
-            glm::vec3 normalDir = glm::normalize(glm::cross(v1 - v0, v2 - v0));
-            glm::vec3 center = (v0 + v1 + v2) / 3.0f;
-            glm::vec3 end = center + normalDir * 0.2f;
-
-
-            glVertex3fv(glm::value_ptr(center));
-            glVertex3fv(glm::value_ptr(end));
-        }
-        glEnd();
-        glUniform1i(glGetUniformLocation(shader.ID, "useLineColor"), false);
+    PROFILE_SCOPE("Mesh::Draw");
+    size_t indexCount = GetIndexCount();
+
+    // the samplers already point at their slot's unit (Shader::Reflect): only the
+    // first texture of each type is sampled, the same ones RenderQueue::Push keeps
+    bool boundSlots[RenderQueue::SLOT_COUNT] = {};
+    for (const TextureHandle& texture : textures) {
+        int slot = RenderQueue::GetSlot(texture.mapType);
+        if (slot < 0 || boundSlots[slot])
+            continue;
+
+        glActiveTexture(GL_TEXTURE0 + slot);
+        glBindTexture(GL_TEXTURE_2D, texture.GetId());
+        boundSlots[slot] = true;
     }
 
-
     glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, (GLsizei)indexCount, GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
 
     glActiveTexture(GL_TEXTURE0); //reset texture units for next draw call!
 }
 
-void Mesh::CalculateNormals() {
-    normals.resize(vertices.size(), glm::vec3(0.0f));
-
-
-    for (int i = 0; i < indices.size(); i += 3) {
-        glm::vec3 v0 = vertices[indices[i]].Position;
-        glm::vec3 v1 = vertices[indices[i + 1]].Position;
-        glm::vec3 v2 = vertices[indices[i + 2]].Position;
+// GL buffers can only go on the main thread, so CalculateNormals just flags them
+void Mesh::DropStaleNormalLines() {
+    if (!normalLinesDirty)
+        return;
+    faceNormalLines.Release();
+    vertNormalLines.Release();
+    normalLinesDirty = false;
+}
 
-        //With just vertices[i] instead of vertices[indices[i]], you’d be assuming that every 3 consecutive vertices form a triangle.
-        //However, that's not always the case, as most meshes reuse vertices between faces.
+const DebugDraw::LineBuffer& Mesh::GetFaceNormalLines() {
+    if (!hasSourceNormals && normals.size() != GetVertexCount())
+        CalculateNormals();
+    DropStaleNormalLines();
+    if (faceNormalLines.IsBuilt())
+        return faceNormalLines;
+
+    PROFILE_SCOPE("Mesh::GetFaceNormalLines");
+    const Vertex* vertexData = GetVertexData();
+    const unsigned int* indexData = GetIndexData();
+    size_t triangleCount = GetIndexCount() / 3;
+    uint32_t green = DebugDraw::PackColor(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+
+    // normal at the first vertex of each triangle, each job fills its own range
+    std::vector<DebugDraw::Vertex> lines(triangleCount * 2);
+    Application::GetInstance().jobs->ParallelFor(triangleCount, [&](size_t t) {
+        unsigned int index = indexData[t * 3];
+        glm::vec3 start = vertexData[index].Position;
+        glm::vec3 normal = hasSourceNormals ? vertexData[index].Normal : normals[index];
+        lines[t * 2] = { start, green };
+        lines[t * 2 + 1] = { start + normal * 0.2f, green };
+    }, NORMAL_GRAIN);
+
+    faceNormalLines.Build(lines);
+    return faceNormalLines;
+}
 
-        glm::vec3 normal = glm::normalize(glm::cross(v1 - v0, v2 - v0));
-        //compute cross product with v0->v1, v0->v2 
-        //both from the same point (v0), because the resulting perpendicular vector has to sit on a common vertex
+const DebugDraw::LineBuffer& Mesh::GetVertNormalLines() {
+    if (faceNormals.size() != GetIndexCount() / 3)
+        CalculateFaceNormals();
+    DropStaleNormalLines();
+    if (vertNormalLines.IsBuilt())
+        return vertNormalLines;
+
+    PROFILE_SCOPE("Mesh::GetVertNormalLines");
+    const Vertex* vertexData = GetVertexData();
+    const unsigned int* indexData = GetIndexData();
+    size_t triangleCount = faceNormals.size();
+    uint32_t cyan = DebugDraw::PackColor(glm::vec4(0.0f, 0.9f, 1.0f, 1.0f));
+
+    // geometric normal at the centre of each triangle
+    std::vector<DebugDraw::Vertex> lines(triangleCount * 2);
+    Application::GetInstance().jobs->ParallelFor(triangleCount, [&](size_t t) {
+        glm::vec3 v0 = vertexData[indexData[t * 3]].Position;
+        glm::vec3 v1 = vertexData[indexData[t * 3 + 1]].Position;
+        glm::vec3 v2 = vertexData[indexData[t * 3 + 2]].Position;
+        glm::vec3 center = (v0 + v1 + v2) / 3.0f;
+        lines[t * 2] = { center, cyan };
+        lines[t * 2 + 1] = { center + faceNormals[t] * 0.2f, cyan };
+    }, NORMAL_GRAIN);
+
+    vertNormalLines.Build(lines);
+    return vertNormalLines;
+}
 
-        //add normal vector on top of each vertex
-        normals[indices[i]] += normal;
-        normals[indices[i + 1]] += normal;
-        normals[indices[i + 2]] += normal;
+void Mesh::CalculateFaceNormals() {
+    PROFILE_SCOPE("Mesh::CalculateFaceNormals");
+    const Vertex* vertexData = GetVertexData();
+    const unsigned int* indexData = GetIndexData();
+    size_t triangleCount = GetIndexCount() / 3;
+    faceNormals.resize(triangleCount);
+
+    // per chunk: gather the cross products into SoA scratch arrays, then normalize
+    // them in a branch free loop over plain floats the compiler can vectorize
+    size_t chunkCount = (triangleCount + NORMAL_GRAIN - 1) / NORMAL_GRAIN;
+    Application::GetInstance().jobs->ParallelFor(chunkCount, [&](size_t chunk) {
+        size_t begin = chunk * NORMAL_GRAIN;
+        size_t count = std::min(NORMAL_GRAIN, triangleCount - begin);
+        float nx[NORMAL_GRAIN], ny[NORMAL_GRAIN], nz[NORMAL_GRAIN];
+
+        for (size_t k = 0; k < count; ++k) {
+            const unsigned int* triangle = indexData + (begin + k) * 3;
+            glm::vec3 v0 = vertexData[triangle[0]].Position;
+            glm::vec3 e1 = vertexData[triangle[1]].Position - v0;
+            glm::vec3 e2 = vertexData[triangle[2]].Position - v0;
+            nx[k] = e1.y * e2.z - e1.z * e2.y;
+            ny[k] = e1.z * e2.x - e1.x * e2.z;
+            nz[k] = e1.x * e2.y - e1.y * e2.x;
+        }
 
-    }
+        for (size_t k = 0; k < count; ++k) {
+            float lengthSq = nx[k] * nx[k] + ny[k] * ny[k] + nz[k] * nz[k];
+            // degenerate triangles get a zero normal instead of NaN
+            float inverse = lengthSq > 0.0f ? 1.0f / std::sqrt(lengthSq) : 0.0f;
+            nx[k] *= inverse;
+            ny[k] *= inverse;
+            nz[k] *= inverse;
+        }
 
-    for (glm::vec3 normal : normals)
-    {
-        //since we added the normals to the indices, they aren't normalized anymore, so we do it again
-        normal = glm::normalize(normal);
-    }
+        for (size_t k = 0; k < count; ++k)
+            faceNormals[begin + k] = glm::vec3(nx[k], ny[k], nz[k]);
+    }, 1);
+}
 
+void Mesh::CalculateNormals() {
+    PROFILE_SCOPE("Mesh::CalculateNormals");
+    normalLinesDirty = true;
+
+    const unsigned int* indexData = GetIndexData();
+    size_t vertexCount = GetVertexCount();
+    size_t cornerCount = GetIndexCount() / 3 * 3;
+
+    CalculateFaceNormals();
+
+    // vertex -> triangles table (CSR), so every vertex sums its own faces and
+    // the parallel pass needs no atomics. Vertices shared between faces get
+    // the average of their faces' normals
+    std::vector<uint32_t> firstFace(vertexCount + 1, 0);
+    for (size_t i = 0; i < cornerCount; ++i)
+        firstFace[indexData[i] + 1]++;
+    for (size_t v = 0; v < vertexCount; ++v)
+        firstFace[v + 1] += firstFace[v];
+
+    std::vector<uint32_t> faces(cornerCount);
+    std::vector<uint32_t> cursor(firstFace.begin(), firstFace.end() - 1);
+    for (size_t i = 0; i < cornerCount; ++i)
+        faces[cursor[indexData[i]]++] = (uint32_t)(i / 3);
+
+    normals.resize(vertexCount);
+    Application::GetInstance().jobs->ParallelFor(vertexCount, [&](size_t v) {
+        glm::vec3 sum(0.0f);
+        for (uint32_t f = firstFace[v]; f < firstFace[v + 1]; ++f)
+            sum += faceNormals[faces[f]];
+
+        float lengthSq = glm::dot(sum, sum);
+        normals[v] = lengthSq > 0.0f ? sum / std::sqrt(lengthSq) : glm::vec3(0.0f);
+    }, NORMAL_GRAIN);
 }
 
-void Mesh::Load() {
+bool Mesh::Load() {
     // Usamos la ruta de Library que ResMan nos ha asignado
     std::string path = GetLibraryPath();
 
     if (path.empty()) {
         std::cout << "[Error Mesh] Ruta de Library vacía." << std::endl;
-        return;
+        return false;
     }
 
-    std::ifstream file(path, std::ios::binary);
-    if (!file.is_open()) {
+    // Mapeamos el archivo entero: el VBO/EBO se rellenan directamente desde el mapping
+    auto file = std::make_shared<MappedFile>();
+    if (!file->Open(path)) {
         std::cout << "[Error Mesh] No se pudo abrir el archivo binario: " << path << std::endl;
-        return;
+        return false;
     }
 
-    // 2. LEER HEADER
-    uint32_t numVertices = 0;
-    uint32_t numIndices = 0;
+    // Los modelos (fbx/obj) se guardan como paquete completo: cargamos su primera malla
+    size_t blobOffset = 0;
+    ModelFormat::View package;
+    if (ModelFormat::Parse(file->GetData(), file->GetSize(), package)) {
+        blobOffset = file->GetSize(); // sin mallas validas -> falla abajo
+        for (uint32_t i = 0; i < package.header->meshCount; i++) {
+            if (!(package.meshes[i].flags & ModelFormat::MESH_SKIPPED)) {
+                blobOffset = (size_t)package.meshes[i].blobOffset;
+                break;
+            }
+        }
+    }
 
-    file.read((char*)&numVertices, sizeof(uint32_t));
-    file.read((char*)&numIndices, sizeof(uint32_t));
+    if (!LoadFromMapped(file, blobOffset)) {
+        // Formato antiguo (sin cabecera) o versión distinta: ResMan lo re-importa
+        std::cout << "[Mesh] Formato de Library obsoleto: " << path << std::endl;
+        return false;
+    }
 
-    // Reservar memoria
-    vertices.resize(numVertices);
-    indices.resize(numIndices);
+    // std::cout << "[Mesh] Cargada correctamente desde Library: " << path << std::endl;
+    return true;
+}
 
-    // 3. LEER VÉRTICES (Coincide con ResMan::ImportMesh)
-    for (uint32_t i = 0; i < numVertices; i++) {
-        file.read((char*)&vertices[i].Position, sizeof(float) * 3);
-        file.read((char*)&vertices[i].Normal, sizeof(float) * 3);
-        file.read((char*)&vertices[i].texCoord, sizeof(float) * 2);
+bool Mesh::LoadFromMapped(std::shared_ptr<MappedFile> file, size_t blobOffset) {
+    if (!file || !file->IsOpen() || blobOffset >= file->GetSize()) return false;
+
+    MeshFormat::View view;
+    if (!MeshFormat::Parse(file->GetData() + blobOffset, file->GetSize() - blobOffset, view)) {
+        return false;
     }
 
-    // 4. LEER ÍNDICES (Lectura en bloque es segura para vectores de enteros)
-    file.read((char*)indices.data(), numIndices * sizeof(unsigned int));
+    mappedFile = file;
+    mappedVertices = view.vertices;
+    mappedIndices = view.indices;
+    mappedVertexCount = view.header->vertexCount;
+    mappedIndexCount = view.header->indexCount;
+
+    vertices.clear();
+    indices.clear();
 
-    file.close();
+    // La AABB ya viene precalculada en el archivo
+    meshAABB.min = glm::vec3(view.bounds->min[0], view.bounds->min[1], view.bounds->min[2]);
+    meshAABB.max = glm::vec3(view.bounds->max[0], view.bounds->max[1], view.bounds->max[2]);
+
+    hasSourceNormals = (view.header->flags & MeshFormat::FLAG_HAS_NORMALS) != 0;
 
-    // 5. Configurar OpenGL y cálculos auxiliares
     setupMesh();
-    CalculateNormals(); // Genera las normales para el debug visual
-    CalculateAABB();    // Genera la caja de colisión
+    triangleBVH.Build(GetVertexData(), GetIndexData(), GetIndexCount()); // picking exacto
 
-    // std::cout << "[Mesh] Cargada correctamente desde Library: " << path << std::endl;
-}
\ No newline at end of file
+    return true;
+}
+
+bool Mesh::RaycastLocal(const glm::vec3& origin, const glm::vec3& direction, float minDistance, float maxDistance, TriangleBVH::Hit& hit) const {
+    return triangleBVH.Raycast(GetVertexData(), GetIndexData(), origin, direction, minDistance, maxDistance, hit);
+}
+
+glm::vec3 Mesh::GetTriangleNormal(uint32_t triangle) const {
+    if (triangle >= GetIndexCount() / 3)
+        return glm::vec3(0.0f);
+
+    const Vertex* vertexData = GetVertexData();
+    const unsigned int* indexData = GetIndexData();
+    glm::vec3 v0 = vertexData[indexData[triangle * 3]].Position;
+    glm::vec3 v1 = vertexData[indexData[triangle * 3 + 1]].Position;
+    glm::vec3 v2 = vertexData[indexData[triangle * 3 + 2]].Position;
+    return glm::normalize(glm::cross(v1 - v0, v2 - v0));
+}
@@ -5,6 +5,7 @@
 
 #include "Shader.h"
 #include "Textures.h"
+#include "TextureCache.h"
 #include <vector>
 #include <SDL3/SDL_opengl.h>
 #include "assimp/cimport.h"
@@ -12,7 +13,10 @@
 #include "assimp/postprocess.h"
 #include "assimp/mesh.h"
 #include <limits>
+#include <memory>
 #include "Resource.h"
+#include "TriangleBVH.h"
+#include "DebugDraw.h"
 
 
 using namespace std;
@@ -30,6 +34,7 @@ struct AABB {
 };
 
 class Texture;
+class MappedFile;
 
 
 class Mesh : public Resource {
@@ -37,32 +42,77 @@ public:
     // mesh data
     vector<Vertex>       vertices;
     vector<unsigned int> indices;
-    vector<Texture>      textures;
+    vector<TextureHandle> textures;
 
-    vector<glm::vec3>    normals;
+    vector<glm::vec3>    normals;        // per vertex, CalculateNormals (only for sources without normals)
+    vector<glm::vec3>    faceNormals;    // per triangle, CalculateFaceNormals
 
     AABB meshAABB;
 
     Mesh() : Resource(ResourceType::MESH, "EmptyMesh") {}
 
     // CORRECCIN: Solo la declaracin, sin cuerpo ni lista de inicializacin
-    Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<Texture> textures);
+    Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<TextureHandle> textures);
 
-    void Load() override;
+    // Loads the Library file at GetLibraryPath(). Returns false for missing or
+    // outdated files so the ResourceManager can re-import them.
+    bool Load() override;
+    // Builds the mesh from a MeshFormat blob inside an already mapped file.
+    // Vertex/index data is not copied: the mapping is kept alive by the mesh.
+    bool LoadFromMapped(std::shared_ptr<MappedFile> file, size_t blobOffset);
+
+    // Vertex/index access that works for both Assimp-built and mapped meshes
+    const Vertex* GetVertexData() const { return mappedFile ? mappedVertices : vertices.data(); }
+    const unsigned int* GetIndexData() const { return mappedFile ? mappedIndices : indices.data(); }
+    size_t GetVertexCount() const { return mappedFile ? mappedVertexCount : vertices.size(); }
+    size_t GetIndexCount() const { return mappedFile ? mappedIndexCount : indices.size(); }
 
     ~Mesh();
+    // Smoothed per vertex normals from the triangles, in parallel on the job system.
+    // Not run at load: only the normal debug lines of meshes imported without normals need them
     void CalculateNormals();
+    void CalculateFaceNormals();
+    // Vertex::Normal came from the source (Assimp / MeshFormat::FLAG_HAS_NORMALS)
+    bool HasSourceNormals() const { return hasSourceNormals; }
     void CalculateAABB();
-    void DrawAABB(Shader& shader, const glm::mat4& modelMatrix, const glm::vec4& color);
     void Draw(Shader& shader);
+    // Mesh space debug lines, uploaded on first use and kept until the normals change.
+    // drawFaceNormals shows the normal at the first vertex of each triangle (green),
+    // drawVertNormals the geometric normal at each triangle's centre (cyan)
+    const DebugDraw::LineBuffer& GetFaceNormalLines();
+    const DebugDraw::LineBuffer& GetVertNormalLines();
+    unsigned int GetVAO() const { return VAO; }
+    // Deletes the VAO/VBO/EBO. CPU data stays, the mesh just stops being drawable
+    void ReleaseGPU();
+
+    // Exact ray test in mesh local space against the triangle BVH built at load
+    bool RaycastLocal(const glm::vec3& origin, const glm::vec3& direction, float minDistance, float maxDistance, TriangleBVH::Hit& hit) const;
+    // Zero for a triangle past the index buffer
+    glm::vec3 GetTriangleNormal(uint32_t triangle) const;
+    const TriangleBVH& GetTriangleBVH() const { return triangleBVH; }
     bool drawVertNormals = false;
     bool drawFaceNormals = false;
 
 
 private:
     //  render data
-    unsigned int VAO, VBO, EBO;
+    unsigned int VAO = 0, VBO = 0, EBO = 0;
+
+    // Library meshes read straight from the mapped file (see MeshFormat.h)
+    std::shared_ptr<MappedFile> mappedFile;
+    const Vertex* mappedVertices = nullptr;
+    const unsigned int* mappedIndices = nullptr;
+    size_t mappedVertexCount = 0;
+    size_t mappedIndexCount = 0;
+
+    TriangleBVH triangleBVH;
+
+    DebugDraw::LineBuffer faceNormalLines;
+    DebugDraw::LineBuffer vertNormalLines;
+    bool normalLinesDirty = true;     // set by CalculateNormals
+    bool hasSourceNormals = false;
 
     void setupMesh();
+    void DropStaleNormalLines();
 
 };
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "MeshFormat.h"
+#include "Mesh.h"
+#include <fstream>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+static_assert(sizeof(unsigned int) == sizeof(uint32_t), "Library index format assumes 32-bit indices");
+static_assert(sizeof(MeshFormat::Header) % 8 == 0, "Header must keep 64-bit offsets aligned");
+
+namespace MeshFormat {
+
+    static void ComputeLayout(Header& header, uint32_t vertexCount, uint32_t indexCount, uint32_t subMeshCount) {
+        header.verticesOffset = Align(sizeof(Header));
+        header.indicesOffset = Align(header.verticesOffset + (uint64_t)vertexCount * sizeof(Vertex));
+        header.boundsOffset = Align(header.indicesOffset + (uint64_t)indexCount * sizeof(uint32_t));
+        header.subMeshesOffset = Align(header.boundsOffset + sizeof(Bounds));
+        header.totalSize = Align(header.subMeshesOffset + (uint64_t)subMeshCount * sizeof(SubMesh));
+    }
+
+    uint64_t ComputeSize(uint32_t vertexCount, uint32_t indexCount, uint32_t subMeshCount) {
+        Header header = {};
+        ComputeLayout(header, vertexCount, indexCount, subMeshCount == 0 ? 1 : subMeshCount);
+        return header.totalSize;
+    }
+
+    static void Pad(std::ostream& out, uint64_t& written, uint64_t target) {
+        static const char zeros[SECTION_ALIGNMENT] = {};
+        while (written < target) {
+            uint64_t chunk = std::min<uint64_t>(target - written, SECTION_ALIGNMENT);
+            out.write(zeros, (std::streamsize)chunk);
+            written += chunk;
+        }
+    }
+
+    bool Write(std::ostream& out, const Vertex* vertices, uint32_t vertexCount,
+        const uint32_t* indices, uint32_t indexCount,
+        const SubMesh* subMeshes, uint32_t subMeshCount, uint32_t flags) {
+
+        SubMesh wholeMesh = { 0, indexCount, 0, 0 };
+        if (subMeshes == nullptr || subMeshCount == 0) {
+            subMeshes = &wholeMesh;
+            subMeshCount = 1;
+        }
+
+        Header header = {};
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.flags = flags;
+        header.vertexStride = sizeof(Vertex);
+        header.vertexCount = vertexCount;
+        header.indexCount = indexCount;
+        header.subMeshCount = subMeshCount;
+        ComputeLayout(header, vertexCount, indexCount, subMeshCount);
+
+        Bounds bounds;
+        for (int axis = 0; axis < 3; ++axis) {
+            bounds.min[axis] = std::numeric_limits<float>::max();
+            bounds.max[axis] = std::numeric_limits<float>::lowest();
+        }
+        for (uint32_t i = 0; i < vertexCount; ++i) {
+            for (int axis = 0; axis < 3; ++axis) {
+                float value = vertices[i].Position[axis];
+                if (value < bounds.min[axis]) bounds.min[axis] = value;
+                if (value > bounds.max[axis]) bounds.max[axis] = value;
+            }
+        }
+
+        // One write per section instead of one per vertex attribute
+        uint64_t written = 0;
+        out.write((const char*)&header, sizeof(Header));
+        written += sizeof(Header);
+
+        Pad(out, written, header.verticesOffset);
+        out.write((const char*)vertices, (std::streamsize)vertexCount * sizeof(Vertex));
+        written += (uint64_t)vertexCount * sizeof(Vertex);
+
+        Pad(out, written, header.indicesOffset);
+        out.write((const char*)indices, (std::streamsize)indexCount * sizeof(uint32_t));
+        written += (uint64_t)indexCount * sizeof(uint32_t);
+
+        Pad(out, written, header.boundsOffset);
+        out.write((const char*)&bounds, sizeof(Bounds));
+        written += sizeof(Bounds);
+
+        Pad(out, written, header.subMeshesOffset);
+        out.write((const char*)subMeshes, (std::streamsize)subMeshCount * sizeof(SubMesh));
+        written += (uint64_t)subMeshCount * sizeof(SubMesh);
+
+        Pad(out, written, header.totalSize);
+
+        return out.good();
+    }
+
+    static bool SectionFits(uint64_t offset, uint64_t bytes, uint64_t blobSize) {
+        return offset % SECTION_ALIGNMENT == 0 && offset <= blobSize && bytes <= blobSize - offset;
+    }
+
+    bool Parse(const uint8_t* data, size_t size, View& view) {
+        if (data == nullptr || size < sizeof(Header)) return false;
+
+        const Header* header = reinterpret_cast<const Header*>(data);
+        if (header->magic != MAGIC || header->version != VERSION) return false;
+        if (header->vertexStride != sizeof(Vertex)) return false;
+        if (header->totalSize > size) return false;
+
+        uint64_t blobSize = header->totalSize;
+        if (!SectionFits(header->verticesOffset, (uint64_t)header->vertexCount * sizeof(Vertex), blobSize) ||
+            !SectionFits(header->indicesOffset, (uint64_t)header->indexCount * sizeof(uint32_t), blobSize) ||
+            !SectionFits(header->boundsOffset, sizeof(Bounds), blobSize) ||
+            !SectionFits(header->subMeshesOffset, (uint64_t)header->subMeshCount * sizeof(SubMesh), blobSize)) {
+            return false;
+        }
+
+        const uint32_t* indices = reinterpret_cast<const uint32_t*>(data + header->indicesOffset);
+        const SubMesh* subMeshes = reinterpret_cast<const SubMesh*>(data + header->subMeshesOffset);
+
+        // A stale or corrupt file must not point past the vertices: everything
+        // downstream (GL draws, triangle BVH, normals) indexes them unchecked
+        for (uint32_t i = 0; i < header->indexCount; i++) {
+            if (indices[i] >= header->vertexCount) return false;
+        }
+        for (uint32_t s = 0; s < header->subMeshCount; s++) {
+            const SubMesh& subMesh = subMeshes[s];
+            if ((uint64_t)subMesh.indexOffset + subMesh.indexCount > header->indexCount) return false;
+            if (subMesh.baseVertex == 0) continue;
+            for (uint32_t i = subMesh.indexOffset; i < subMesh.indexOffset + subMesh.indexCount; i++) {
+                if ((uint64_t)indices[i] + subMesh.baseVertex >= header->vertexCount) return false;
+            }
+        }
+
+        view.header = header;
+        view.vertices = reinterpret_cast<const Vertex*>(data + header->verticesOffset);
+        view.indices = indices;
+        view.bounds = reinterpret_cast<const Bounds*>(data + header->boundsOffset);
+        view.subMeshes = subMeshes;
+        return true;
+    }
+
+    bool IsCurrent(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+
+        Header header = {};
+        if (!file.read((char*)&header, sizeof(Header))) return false;
+
+        return header.magic == MAGIC && header.version == VERSION && header.vertexStride == sizeof(Vertex);
+    }
+}
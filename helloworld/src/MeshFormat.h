@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <ostream>
+
+struct Vertex;
+
+// Binary layout of a mesh stored in Assets/Library.
+//
+//   [Header][Vertices][Indices][Bounds][SubMesh table]
+//
+// Every section starts on a SECTION_ALIGNMENT boundary and is addressed by an
+// offset from the start of the header, so a loader can map the file and hand
+// the section pointers straight to OpenGL without copying anything.
+// Files written before this format existed have no header at all (they start
+// with the vertex count), which is how IsCurrent() tells them apart.
+namespace MeshFormat {
+
+    constexpr uint32_t MAGIC = 0x48534D56; // "VMSH"
+    constexpr uint32_t VERSION = 1;
+    constexpr uint32_t SECTION_ALIGNMENT = 16;
+
+    enum Flags : uint32_t {
+        FLAG_NONE = 0,
+        FLAG_HAS_NORMALS = 1 << 0,
+        FLAG_HAS_TEXCOORDS = 1 << 1
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t flags;
+        uint32_t vertexStride;   // sizeof(Vertex) at write time
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint32_t subMeshCount;
+        uint32_t reserved;
+        uint64_t verticesOffset;
+        uint64_t indicesOffset;
+        uint64_t boundsOffset;
+        uint64_t subMeshesOffset;
+        uint64_t totalSize;      // size of the whole blob, header included
+    };
+
+    struct Bounds {
+        float min[3];
+        float max[3];
+    };
+
+    struct SubMesh {
+        uint32_t indexOffset;
+        uint32_t indexCount;
+        uint32_t baseVertex;
+        uint32_t materialIndex;
+    };
+
+    // Pointers into a validated blob. They are only valid while the memory
+    // the blob was parsed from is alive.
+    struct View {
+        const Header* header = nullptr;
+        const Vertex* vertices = nullptr;
+        const uint32_t* indices = nullptr;
+        const Bounds* bounds = nullptr;
+        const SubMesh* subMeshes = nullptr;
+    };
+
+    inline uint64_t Align(uint64_t value, uint64_t alignment = SECTION_ALIGNMENT) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    // Size in bytes that Write() will produce for the given counts
+    uint64_t ComputeSize(uint32_t vertexCount, uint32_t indexCount, uint32_t subMeshCount);
+
+    // Writes a complete blob at the current position of 'out'. Offsets inside the
+    // header are relative to that position. When subMeshes is null a single
+    // submesh covering every index is written.
+    bool Write(std::ostream& out, const Vertex* vertices, uint32_t vertexCount,
+        const uint32_t* indices, uint32_t indexCount,
+        const SubMesh* subMeshes, uint32_t subMeshCount, uint32_t flags);
+
+    // Checks magic, version, section bounds, submesh ranges and that every index
+    // is below vertexCount, then fills 'view'
+    bool Parse(const uint8_t* data, size_t size, View& view);
+
+    // Reads only the header of a Library file; false for missing, legacy or outdated files
+    bool IsCurrent(const std::string& path);
+}
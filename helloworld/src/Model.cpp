@@ -10,25 +10,22 @@
 #include <algorithm>
 #include "Mesh.h"
 #include "assimp/importer.hpp"
-#include "stb_image.h"
 #include "Textures.h"
+#include "TextureCache.h"
+#include "RenderQueue.h"
 #include "Log.h"
 #include "GUIManager.h"
+#include "ResMan.h"
+#include "MappedFile.h"
+#include "ModelFormat.h"
+#include "PoolAllocator.h"
+#include <chrono>
+#include "Profiler.h"
 
 using namespace std;
 
 
 void Model::loadModel(string path) {
-    Assimp::Importer import;
-    const aiScene* scene = import.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs);
-
-    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
-        cout << "ERROR::ASSIMP::" << import.GetErrorString() << endl;
-        return;
-    }
-
-    
-
     fullPath = path;
     std::replace(fullPath.begin(), fullPath.end(), '\\', '/');
     LOG("FullPath = %s", fullPath.c_str());
@@ -45,22 +42,30 @@ void Model::loadModel(string path) {
     }
 
 
-    stbi_set_flip_vertically_on_load(fileExtension == "obj");
+    // GameObjects and components of this model go to its own arena
+    ArenaScope arenaScope(arena);
+    PoolArena::Stats allocStart = PoolArena::GetGlobalStats();
 
-    rootGameObject = make_shared<GameObject>(fileName);
-    Application::GetInstance().guiManager.get()->sceneObjects.push_back(rootGameObject);
-    rootGameObject.get()->SetOwnerModel(this);
+    auto loadStart = std::chrono::steady_clock::now();
 
-    rootGameObject->AddComponent(ComponentType::TRANSFORM);
-    /*processNodeWithGameObjects(scene->mRootNode, scene, rootGameObject);*/
-    for (int i = 0; i < scene->mRootNode->mNumChildren; i++) {
-        processNodeWithGameObjects(scene->mRootNode->mChildren[i], scene, rootGameObject);
+    // Library package first (mapped, no parsing); Assimp only when there is none
+    bool fromLibrary = loadModelFromLibrary(fullPath);
+    if (!fromLibrary) {
+        loadModelWithAssimp(fullPath);
     }
 
+    double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+
     LOG("Finished Loading Model");
     LOG("=== MODEL LOADING SUMMARY ===");
+    LOG("Source: %s (%.2f ms)", fromLibrary ? "Library package" : "Assimp", loadMs);
     LOG("Total GameObjects created: %d", (int)gameObjects.size());
     LOG("Total Meshes processed: %d", (int)meshes.size());
+    const PoolArena::Stats& allocEnd = PoolArena::GetGlobalStats();
+    LOG("Objects allocated: %llu, heap calls: %llu (%s)",
+        (unsigned long long)(allocEnd.allocations - allocStart.allocations),
+        (unsigned long long)(allocEnd.heapAllocations - allocStart.heapAllocations),
+        PoolArena::enabled ? "pooled" : "pooling off");
     LOG("Root GameObject: '%s'", rootGameObject ? rootGameObject->GetName().c_str() : "NULL");
 
     if (rootGameObject) {
@@ -69,8 +74,185 @@ void Model::loadModel(string path) {
     }
 }
 
+void Model::loadModelWithAssimp(const string& path) {
+    Assimp::Importer import;
+    const aiScene* scene = import.ReadFile(path, ResourceManager::ModelImportFlags);
+
+    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
+        cout << "ERROR::ASSIMP::" << import.GetErrorString() << endl;
+        return;
+    }
+
+    rootGameObject = MakePooled<GameObject>(fileName);
+    Application::GetInstance().guiManager.get()->sceneObjects.push_back(rootGameObject);
+    rootGameObject.get()->SetOwnerModel(this);
+
+    rootGameObject->AddComponent(ComponentType::TRANSFORM);
+    /*processNodeWithGameObjects(scene->mRootNode, scene, rootGameObject);*/
+    for (int i = 0; i < scene->mRootNode->mNumChildren; i++) {
+        processNodeWithGameObjects(scene->mRootNode->mChildren[i], scene, rootGameObject);
+    }
+}
+
+bool Model::loadModelFromLibrary(const string& path) {
+    // Solo los assets del proyecto tienen .meta y Library; lo que se arrastra desde fuera va por Assimp
+    if (path.rfind("Assets/", 0) != 0) return false;
+
+    string packagePath = ResourceManager::GetInstance().GetModelPackage(path);
+    if (packagePath.empty()) return false;
+
+    auto file = make_shared<MappedFile>();
+    ModelFormat::View view;
+    if (!file->Open(packagePath) || !ModelFormat::Parse(file->GetData(), file->GetSize(), view) || view.header->nodeCount == 0) {
+        LOG("Library package for %s is not valid, falling back to Assimp", path.c_str());
+        return false;
+    }
+
+    // 1. Meshes: one per scene mesh, shared by every node that references it.
+    // They are all created before touching the scene so a bad blob can still fall back to Assimp.
+    vector<shared_ptr<Mesh>> packageMeshes(view.header->meshCount);
+    for (uint32_t i = 0; i < view.header->nodeMeshCount; i++) {
+        uint32_t meshIndex = view.nodeMeshes[i];
+        const ModelFormat::MeshEntry& entry = view.meshes[meshIndex];
+        if (packageMeshes[meshIndex] || (entry.flags & ModelFormat::MESH_SKIPPED)) continue;
+
+        auto mesh = make_shared<Mesh>();
+        if (!mesh->LoadFromMapped(file, entry.blobOffset)) {
+            LOG("Mesh %u of %s could not be read from the package, falling back to Assimp", meshIndex, path.c_str());
+            return false;
+        }
+        packageMeshes[meshIndex] = mesh;
+    }
+
+    // 2. Textures per material, resolved next to the model like loadMaterialTextures does
+    vector<vector<TextureHandle>> materialTextures(view.header->materialCount);
+    for (uint32_t m = 0; m < view.header->materialCount; m++) {
+        const ModelFormat::Material& material = view.materials[m];
+        for (uint32_t t = 0; t < material.textureCount; t++) {
+            const ModelFormat::TextureRef& ref = view.textures[material.firstTexture + t];
+            string textureName = view.GetString(ref.fileNameOffset);
+            materialTextures[m].push_back(GetOrLoadTexture(directory + "/" + textureName, textureName, view.GetString(ref.typeNameOffset)));
+        }
+    }
+
+    for (uint32_t i = 0; i < view.header->meshCount; i++) {
+        shared_ptr<Mesh>& mesh = packageMeshes[i];
+        if (!mesh) continue;
+
+        uint32_t materialIndex = view.meshes[i].materialIndex;
+        if (materialIndex < view.header->materialCount && !materialTextures[materialIndex].empty()) {
+            mesh->textures = materialTextures[materialIndex];
+        }
+        else {
+            glm::vec4 diffuseColor(1.0f);
+            if (materialIndex < view.header->materialCount && (view.materials[materialIndex].flags & ModelFormat::MATERIAL_HAS_DIFFUSE_COLOR)) {
+                const float* color = view.materials[materialIndex].diffuseColor;
+                diffuseColor = glm::vec4(color[0], color[1], color[2], color[3]);
+            }
+            mesh->textures.push_back(CreateSolidColorTexture(diffuseColor, "texture_diffuse"));
+        }
+        meshes.push_back(mesh);
+    }
+
+    auto attachMesh = [&](shared_ptr<GameObject> gameObject, uint32_t meshIndex) {
+        shared_ptr<Mesh> mesh = packageMeshes[meshIndex];
+        if (!mesh) return; // lines/points, ignored like in createComponentsForMesh
+
+        auto renderer = std::dynamic_pointer_cast<RenderMeshComponent>(gameObject->AddComponent(ComponentType::MESH_RENDERER));
+        if (renderer) {
+            renderer->SetMesh(mesh);
+            renderer->drawAABB = true;
+        }
+
+        auto matComponent = std::dynamic_pointer_cast<MaterialComponent>(gameObject->AddComponent(ComponentType::MATERIAL));
+        uint32_t materialIndex = view.meshes[meshIndex].materialIndex;
+        if (matComponent && materialIndex < view.header->materialCount) {
+            const ModelFormat::Material& material = view.materials[materialIndex];
+            if (material.flags & ModelFormat::MATERIAL_HAS_DIFFUSE_COLOR) {
+                matComponent->SetDiffuseColor(glm::vec4(material.diffuseColor[0], material.diffuseColor[1], material.diffuseColor[2], material.diffuseColor[3]));
+            }
+            if (material.flags & ModelFormat::MATERIAL_HAS_SHININESS) {
+                matComponent->SetShininess(material.shininess);
+            }
+        }
+    };
+
+    // 3. Hierarchy. Node 0 is the scene root, which maps to our root GameObject (same as the Assimp path)
+    rootGameObject = MakePooled<GameObject>(fileName);
+    Application::GetInstance().guiManager.get()->sceneObjects.push_back(rootGameObject);
+    rootGameObject.get()->SetOwnerModel(this);
+    rootGameObject->AddComponent(ComponentType::TRANSFORM);
+
+    vector<shared_ptr<GameObject>> nodeObjects(view.header->nodeCount);
+    nodeObjects[0] = rootGameObject;
+
+    for (uint32_t i = 1; i < view.header->nodeCount; i++) {
+        const ModelFormat::Node& node = view.nodes[i];
+        if (node.parent == ModelFormat::NO_PARENT) continue;
+
+        auto gameObject = MakePooled<GameObject>(view.GetString(node.nameOffset));
+        gameObjects.push_back(gameObject);
+        nodeObjects[i] = gameObject;
+
+        auto transform = static_cast<TransformComponent*>(gameObject->AddComponent(ComponentType::TRANSFORM).get());
+        transform->SetPosition(glm::vec3(node.position[0], node.position[1], node.position[2]));
+        transform->SetRotation(glm::quat(node.rotation[0], node.rotation[1], node.rotation[2], node.rotation[3]));
+        transform->SetScale(glm::vec3(node.scale[0], node.scale[1], node.scale[2]));
+
+        if (nodeObjects[node.parent]) {
+            gameObject->SetParent(nodeObjects[node.parent]);
+        }
+
+        for (uint32_t m = 0; m < node.meshCount; m++) {
+            uint32_t meshIndex = view.nodeMeshes[node.firstMesh + m];
+
+            if (node.meshCount > 1) {
+                auto meshGO = MakePooled<GameObject>(gameObject->GetName() + "_Mesh" + to_string(m));
+                gameObjects.push_back(meshGO);
+
+                meshGO->AddComponent(ComponentType::TRANSFORM);
+                meshGO->SetParent(gameObject);
+
+                attachMesh(meshGO, meshIndex);
+            }
+            else {
+                attachMesh(gameObject, meshIndex);
+            }
+        }
+    }
+
+    processedMeshes += (int)meshes.size();
+    return true;
+}
+
+std::string Model::ClassifyTextureType(const std::string& fileName, const std::string& defaultType) {
+    string lowerFilename = fileName;
+    std::transform(lowerFilename.begin(), lowerFilename.end(), lowerFilename.begin(), ::tolower);
+
+    if (lowerFilename.find("_c.") != string::npos || lowerFilename.find("_color.") != string::npos) {
+        return "texture_diffuse";
+    }
+    else if (lowerFilename.find("_n.") != string::npos || lowerFilename.find("normal.") != string::npos) {
+        return "texture_normal";
+    }
+    else if (lowerFilename.find("_s.") != string::npos || lowerFilename.find("specular.") != string::npos) {
+        return "texture_specular";
+    }
+    else if (lowerFilename.find("_r.") != string::npos || lowerFilename.find("roughness.") != string::npos) {
+        return "texture_roughness";
+    }
+    else if (lowerFilename.find("_m.") != string::npos || lowerFilename.find("metallic.") != string::npos) {
+        return "texture_metallic";
+    }
+    else if (lowerFilename.find("ao.") != string::npos || lowerFilename.find("ambient.") != string::npos) {
+        return "texture_ao";
+    }
+    return defaultType;
+}
+
 Model::Model(Mesh mesh) {
-    auto gameObject = make_shared<GameObject>();
+    ArenaScope arenaScope(arena);
+    auto gameObject = MakePooled<GameObject>();
     gameObjects.push_back(gameObject);
     rootGameObject = gameObject;
     
@@ -118,63 +300,50 @@ Model::Model(Mesh mesh) {
     string checkersTexName = checkersTexDir.substr(checkersTexDir.find_last_of('/') + 1);
     
 
-    Texture defaultColorTex = GetOrLoadTexture(checkersTexDir, checkersTexName, "texture_diffuse");
+    TextureHandle defaultColorTex = GetOrLoadTexture(checkersTexDir, checkersTexName, "texture_diffuse");
     modelMesh->GetMesh().get()->textures.push_back(defaultColorTex);
 
-    modelMat->SetDiffuseMap(std::make_shared<Texture>(defaultColorTex));
+    modelMat->SetDiffuseMap(defaultColorTex);
 
     LOG("  - Added Material component with default texture");
      
 }
 
 Model::Model() {
+    ArenaScope arenaScope(arena);
     //create root
-    rootGameObject = std::make_shared<GameObject>("EmptyObject");
+    rootGameObject = MakePooled<GameObject>("EmptyObject");
     gameObjects.push_back(rootGameObject);
     rootGameObject->AddComponent(ComponentType::TRANSFORM);
 
     LOG("Empty Object created successfully");
 }
 
-void Model::Draw(Shader& shader) {
-    for (auto& gameObject : gameObjects) {
-        //check if object is active and is not to be destroyed
-        if (!gameObject || gameObject->IsMarkedForDestroy() || !gameObject->IsActive())
-            continue;
+// Main thread (the texture cache may load the checker), only does work on the frame the toggle changes
+void Model::UpdateDefaultTexture() {
+    if (useDefaultTexture == defaultTextureApplied)
+        return;
+    defaultTextureApplied = useDefaultTexture;
 
-        //check for mesh renderer
-        auto rendererComp = gameObject->GetComponent(ComponentType::MESH_RENDERER);
-        if (!rendererComp)
-            continue;
+    TextureHandle checkersTex;
+    if (useDefaultTexture) {
+        std::string checkersTexDir = Application::GetInstance().textures->defaultTexDir;
+        std::string checkersTexName = checkersTexDir.substr(checkersTexDir.find_last_of('/') + 1);
+        checkersTex = GetOrLoadTexture(checkersTexDir, checkersTexName, "texture_diffuse");
+    }
 
-        auto renderer = std::dynamic_pointer_cast<RenderMeshComponent>(rendererComp);
+    for (auto& gameObject : gameObjects) {
+        auto renderer = gameObject ? gameObject->GetComponent<RenderMeshComponent>() : nullptr;
         if (!renderer || !renderer->GetMesh())
             continue;
 
-        auto mesh = renderer->GetMesh();
-        if (!mesh) continue;
-
-        
-        auto transformComp = gameObject->GetComponent(ComponentType::TRANSFORM);
-        if (!transformComp) continue;
-        auto transform = std::dynamic_pointer_cast<TransformComponent>(transformComp);
-        if (!transform) continue;
-
-        glm::mat4 modelMatrix = transform->GetGlobalTransform();
-        
-        //trigger checkerboard texture
+        const auto& mesh = renderer->GetMesh();
         if (useDefaultTexture) {
             //store original texture if not yet stored
-            if (originalTextures.find(mesh) == originalTextures.end()) {
+            if (originalTextures.find(mesh) == originalTextures.end())
                 originalTextures[mesh] = mesh->textures;
-            }
 
             mesh->textures.clear();
-
-            std::string checkersTexDir = Application::GetInstance().textures->defaultTexDir;
-            std::string checkersTexName = checkersTexDir.substr(checkersTexDir.find_last_of('/') + 1);
-            Texture checkersTex = GetOrLoadTexture(checkersTexDir, checkersTexName, "texture_diffuse");
-
             mesh->textures.push_back(checkersTex);
         }
         else {
@@ -182,20 +351,40 @@ void Model::Draw(Shader& shader) {
             auto ogTex = originalTextures.find(mesh);
             if (ogTex != originalTextures.end()) {
                 mesh->textures = ogTex->second;
-                //originalTextures.erase(ogTex);
+                originalTextures.erase(ogTex);
             }
-
         }
+    }
+}
+
+// No GL calls and no scene changes: may run on the frame pipeline worker
+void Model::CollectDrawItems(RenderQueue& queue, GLuint program) {
+    PROFILE_SCOPE("Model::CollectDrawItems");
+    for (auto& gameObject : gameObjects) {
+        //check if object is active and is not to be destroyed
+        if (!gameObject || gameObject->IsMarkedForDestroy() || !gameObject->IsActive())
+            continue;
+
+        //check for mesh renderer
+        auto renderer = gameObject->GetComponent<RenderMeshComponent>();
+        if (!renderer || !renderer->GetMesh())
+            continue;
+
+        const auto& mesh = renderer->GetMesh();
+        if (!mesh) continue;
+
         
-        GLint modelLoc = glGetUniformLocation(shader.ID, "model");
-        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(modelMatrix));
+        auto transform = gameObject->GetComponent<TransformComponent>();
+        if (!transform) continue;
 
-        if (gameObject->isSelected) {
-            mesh->DrawAABB(shader, modelMatrix, glm::vec4(1.0f, 0.0f, 1.0f, 1.0f));
-        }
+        glm::mat4 modelMatrix = transform->GetGlobalTransform();
 
-        //draw the mesh
-        renderer->GetMesh()->Draw(shader);
+        //outside the camera frustum: skip before touching textures
+        if (!queue.IsVisible(renderer->GetWorldAABB(*transform)))
+            continue;
+        
+        //drawn later, sorted with every other model (AABB of the selection included)
+        queue.Push(*mesh, program, modelMatrix, gameObject->isSelected);
     }
 }
 
@@ -223,7 +412,7 @@ std::string Model::normalizePath(const std::string& path) {
 }
 
 void Model::processNodeWithGameObjects(aiNode* node, const aiScene* scene, shared_ptr<GameObject> parent) {
-    auto gameObject = make_shared<GameObject>(node->mName.C_Str());
+    auto gameObject = MakePooled<GameObject>(node->mName.C_Str());
     gameObjects.push_back(gameObject);
 
     LOG("Created GameObject: '%s' (Parent: '%s')",
@@ -257,7 +446,7 @@ void Model::processNodeWithGameObjects(aiNode* node, const aiScene* scene, share
 
         if (node->mNumMeshes > 1) {
             string meshName = string(node->mName.C_Str()) + "_Mesh" + to_string(i);
-            auto meshGO = make_shared<GameObject>(meshName);
+            auto meshGO = MakePooled<GameObject>(meshName);
             gameObjects.push_back(meshGO);
 
             meshGO->AddComponent(ComponentType::TRANSFORM);
@@ -279,7 +468,7 @@ void Model::processNodeWithGameObjects(aiNode* node, const aiScene* scene, share
 Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene) {
     vector<Vertex> vertices;
     vector<unsigned int> indices;
-    vector<Texture> textures;
+    vector<TextureHandle> textures;
     
 
     for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
@@ -327,8 +516,8 @@ Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene) {
     return Mesh(vertices, indices, textures);
 }
 
-vector<Texture> Model::loadMaterialTextures(aiMaterial* mat, aiTextureType type, string typeName) {
-    vector<Texture> textures;
+vector<TextureHandle> Model::loadMaterialTextures(aiMaterial* mat, aiTextureType type, string typeName) {
+    vector<TextureHandle> textures;
 
     for (unsigned int i = 0; i < mat->GetTextureCount(type); i++) {
         aiString str;
@@ -343,28 +532,7 @@ vector<Texture> Model::loadMaterialTextures(aiMaterial* mat, aiTextureType type,
         string fullTexturePath = directory + "/" + filename;
 
         // 3. Determinar el tipo de textura automáticamente por el nombre (tu lógica actual)
-        string currentTypeName = typeName;
-        string lowerFilename = filename;
-        std::transform(lowerFilename.begin(), lowerFilename.end(), lowerFilename.begin(), ::tolower);
-
-        if (lowerFilename.find("_c.") != string::npos || lowerFilename.find("_color.") != string::npos) {
-            currentTypeName = "texture_diffuse";
-        }
-        else if (lowerFilename.find("_n.") != string::npos || lowerFilename.find("normal.") != string::npos) {
-            currentTypeName = "texture_normal";
-        }
-        else if (lowerFilename.find("_s.") != string::npos || lowerFilename.find("specular.") != string::npos) {
-            currentTypeName = "texture_specular";
-        }
-        else if (lowerFilename.find("_r.") != string::npos || lowerFilename.find("roughness.") != string::npos) {
-            currentTypeName = "texture_roughness";
-        }
-        else if (lowerFilename.find("_m.") != string::npos || lowerFilename.find("metallic.") != string::npos) {
-            currentTypeName = "texture_metallic";
-        }
-        else if (lowerFilename.find("ao.") != string::npos || lowerFilename.find("ambient.") != string::npos) {
-            currentTypeName = "texture_ao";
-        }
+        string currentTypeName = ClassifyTextureType(filename, typeName);
 
         LOG("Textura detectada: %s (Tipo: %s)", fullTexturePath.c_str(), currentTypeName.c_str());
 
@@ -374,18 +542,24 @@ vector<Texture> Model::loadMaterialTextures(aiMaterial* mat, aiTextureType type,
     return textures;
 }
 
-Texture Model::CreateSolidColorTexture(glm::vec4 color, const std::string& typeName) {
-    Texture texture;
-
-    glGenTextures(1, &texture.id);
-
+TextureHandle Model::CreateSolidColorTexture(glm::vec4 color, const std::string& typeName) {
     unsigned char data[4];
     data[0] = (unsigned char)(color.r * 255.0f); // R
     data[1] = (unsigned char)(color.g * 255.0f); // G
     data[2] = (unsigned char)(color.b * 255.0f); // B
     data[3] = (unsigned char)(color.a * 255.0f); // A
 
-    glBindTexture(GL_TEXTURE_2D, texture.id);
+    // Un color = una textura de 1x1 para todo el proyecto
+    char key[32];
+    snprintf(key, sizeof(key), "SolidColor:%02x%02x%02x%02x", data[0], data[1], data[2], data[3]);
+    auto cache = Application::GetInstance().textures->cache;
+    TextureHandle cached = cache->Find(key, typeName);
+    if (cached) return cached;
+
+    GLuint id = 0;
+    glGenTextures(1, &id);
+
+    glBindTexture(GL_TEXTURE_2D, id);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -393,14 +567,9 @@ Texture Model::CreateSolidColorTexture(glm::vec4 color, const std::string& typeN
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-    texture.mapType = typeName;
-    texture.path = "GeneratedSolidColor";
-
-    Application::GetInstance().textures.get()->textures_loaded.push_back(texture);
-
     LOG("Created 1x1 solid color texture for material.");
 
-    return texture;
+    return cache->Adopt(key, id, typeName);
 }
 
 void Model::createComponentsForMesh(std::shared_ptr<GameObject> gameObject, aiMesh* aiMesh, const aiScene* scene)
@@ -416,7 +585,7 @@ void Model::createComponentsForMesh(std::shared_ptr<GameObject> gameObject, aiMe
 
     std::vector<Vertex> vertices;
     std::vector<unsigned int> indices;
-    std::vector<Texture> textures;
+    std::vector<TextureHandle> textures;
 
     // --- Process vertices ---
     for (unsigned int i = 0; i < aiMesh->mNumVertices; ++i)
@@ -495,7 +664,7 @@ void Model::createComponentsForMesh(std::shared_ptr<GameObject> gameObject, aiMe
     }
 
     if (textures.empty()) {
-        Texture solidTex = CreateSolidColorTexture(diffuseColor, "texture_diffuse");
+        TextureHandle solidTex = CreateSolidColorTexture(diffuseColor, "texture_diffuse");
         textures.push_back(solidTex);
         LOG("Assigned solid color texture (based on material color) to mesh.");
     }
@@ -544,7 +713,8 @@ void Model::createComponentsForMesh(std::shared_ptr<GameObject> gameObject, aiMe
 }
 
 Model::~Model() {
-    // shared_ptr automatically cleans up
+    // shared_ptr automatically cleans up; the arena slabs go in one go once the
+    // last GameObject/component allocated from them is released
 }
 
 void Model::LogGameObjectHierarchy(shared_ptr<GameObject> go, int depth) {
@@ -563,62 +733,12 @@ void Model::LogGameObjectHierarchy(shared_ptr<GameObject> go, int depth) {
 }
 
 
-void Model::DestroyGameObject(std::shared_ptr<GameObject> gameObject) {
-    if (!gameObject) {
-        LOG("WARNING: Attempted to destroy null GameObject");
-        return;
-    }
-
-    LOG("Destroying GameObject '%s'", gameObject->GetName().c_str());
-
-    // Marcar este GameObject
-    gameObject->MarkForDestroy();
-
-    // Lambda recursiva sin std::function
-    auto markChildren = [&](auto&& self, std::shared_ptr<GameObject> go) -> void {
-        for (auto& child : go->GetChildren()) {
-            if (child && !child->IsMarkedForDestroy()) {
-                LOG("  - Marking child '%s' for destruction", child->GetName().c_str());
-                child->MarkForDestroy();
-                self(self, child);  // recursi�n
-            }
-        }
-        };
-
-    // Llamar con la funci�n y el objeto ra�z
-    markChildren(markChildren, gameObject);
-
-    // Desconectar del padre
-    if (auto parent = gameObject->GetParent()) {
-        parent->RemoveChild(gameObject);
-        LOG("  - Disconnected from parent '%s'", parent->GetName().c_str());
-    }
-}
-
-void Model::CleanUpDestroyedObjects() {
-    size_t beforeCount = gameObjects.size();
-
-    // Eliminar GameObjects marcados
-    gameObjects.erase(
-        std::remove_if(gameObjects.begin(), gameObjects.end(),
-            [](const std::shared_ptr<GameObject>& go) {
-                return go && go->IsMarkedForDestroy();
-            }),
-        gameObjects.end()
-    );
-
-    size_t afterCount = gameObjects.size();
-    if (beforeCount != afterCount) {
-        LOG("Cleanup: Removed %d GameObject(s). Remaining: %d",
-            (int)(beforeCount - afterCount), (int)afterCount);
-    }
-}
-
 std::shared_ptr<GameObject> Model::CreateEmptyGameObject(const std::string& name, std::shared_ptr<GameObject> parent) {
     LOG("Creating empty GameObject: '%s'", name.c_str());
+    ArenaScope arenaScope(arena);
 
     // Crear GameObject vac�o
-    auto newGameObject = std::make_shared<GameObject>(name);
+    auto newGameObject = MakePooled<GameObject>(name);
 
     // A�adir Transform (todos los GameObjects necesitan Transform)
     newGameObject->AddComponent(ComponentType::TRANSFORM);
@@ -643,48 +763,24 @@ std::shared_ptr<GameObject> Model::CreateEmptyGameObject(const std::string& name
     return newGameObject;
 }
 
-Texture Model::GetOrLoadTexture(const string& fullPath, const string& fileName, const string& typeName) {
-
-    auto& textures_loaded = Application::GetInstance().textures.get()->textures_loaded;
-    // Check if already loaded
-    for (auto& loadedTex : textures_loaded) {
-        if (loadedTex.path == fullPath) {
-            return loadedTex; // Return the cached texture
-        }
-    }
-
-   
-    Texture texture;
-
-    
-    string directory = "";
-    size_t lastSlash = fullPath.find_last_of('/');
-    if (lastSlash != string::npos) {
-        directory = fullPath.substr(0, lastSlash);
-    }
-
-    texture.TextureFromFile(directory, fileName.c_str());
-    // -----------------------
-
-    texture.mapType = typeName;
-    texture.path = fullPath;
-    textures_loaded.push_back(texture);
-
-    return texture;
+TextureHandle Model::GetOrLoadTexture(const string& fullPath, const string& fileName, const string& typeName) {
+    // Cache por ruta normalizada: la primera vez se pide en segundo plano, despues es un lookup.
+    // Las texturas de los obj se cargan giradas
+    return Application::GetInstance().textures->cache->Acquire(fullPath, typeName, true, fileExtension == "obj");
 }
 
-void Model::AssignDefaultTexture(std::vector<Texture>& textures) {
+void Model::AssignDefaultTexture(std::vector<TextureHandle>& textures) {
     string fullPath = Application::GetInstance().textures.get()->defaultTexDir;
     string fileName = fullPath.substr(fullPath.find_last_of('/') + 1);
     string directory = fullPath.substr(0, fullPath.find_last_of('/') + 1);
 
     LOG("AssignDefaultTexture: fullPath=%s, fileName=%s", fullPath.c_str(), fileName.c_str());
 
-    Texture defaultTex = GetOrLoadTexture(fullPath, fileName, "texture_diffuse");
+    TextureHandle defaultTex = GetOrLoadTexture(fullPath, fileName, "texture_diffuse");
 
-    if (defaultTex.id != 0) {
+    if (defaultTex.GetId() != 0) {
         textures.push_back(defaultTex);
-        LOG("  -> Default texture assigned (ID: %d)", defaultTex.id);
+        LOG("  -> Default texture assigned (ID: %d)", defaultTex.GetId());
     }
     else {
         LOG("  -> ERROR: Failed to assign default texture!");
@@ -2,11 +2,15 @@
 #include "Shader.h"
 #include "Mesh.h"
 #include "Textures.h"
+#include "TextureCache.h"
 #include "GameObject.h"
+#include "PoolAllocator.h"
 #include <vector>
 #include <string>
 #include <unordered_map>
 
+class RenderQueue;
+
 class Model {
 public:
     Model(std::string path) 
@@ -19,9 +23,12 @@ public:
     ~Model();
 
     
-    std::shared_ptr<Texture> savedTexture;
+    TextureHandle savedTexture;
 
-    void Draw(Shader& shader);
+    // One draw item per active mesh renderer, see RenderQueue
+    void CollectDrawItems(RenderQueue& queue, GLuint program);
+    // Swaps the meshes to the checker texture (or back) when useDefaultTexture changed
+    void UpdateDefaultTexture();
     std::string normalizePath(const std::string& path);
     std::vector<std::shared_ptr<Mesh>> meshes;
     std::shared_ptr<GameObject> rootGameObject;
@@ -34,18 +41,29 @@ public:
         return rootGameObject; 
     }
 
-    Texture CreateSolidColorTexture(glm::vec4 color, const std::string& typeName);
+    TextureHandle CreateSolidColorTexture(glm::vec4 color, const std::string& typeName);
     
     std::string fileName, fileExtension, directory;
     int processedMeshes = 0;
 
     //store original texture for later use
     bool useDefaultTexture = false;
-    std::unordered_map<std::shared_ptr<Mesh>, std::vector<Texture>> originalTextures;
+    bool defaultTextureApplied = false;
+    std::unordered_map<std::shared_ptr<Mesh>, std::vector<TextureHandle>> originalTextures;
 
     std::string fullPath;
 
+    // Slabs for the GameObjects/components of this model (see PoolAllocator.h)
+    std::shared_ptr<PoolArena> arena = std::make_shared<PoolArena>();
+
     void loadModel(std::string path);
+    // Rebuilds the whole hierarchy from the Library model package (no Assimp).
+    // False when the asset has no usable package, loadModel then falls back to Assimp.
+    bool loadModelFromLibrary(const std::string& path);
+    void loadModelWithAssimp(const std::string& path);
+
+    // "texture_diffuse", "texture_normal"... from the file name suffix, defaultType if nothing matches
+    static std::string ClassifyTextureType(const std::string& fileName, const std::string& defaultType);
     
    /* void processNode(aiNode* node, const aiScene* scene);*/
     Mesh processMesh(aiMesh* mesh, const aiScene* scene);
@@ -53,14 +71,12 @@ public:
     void processNodeWithGameObjects(aiNode* node, const aiScene* scene, std::shared_ptr<GameObject> parent);
     void createComponentsForMesh(std::shared_ptr<GameObject> gameObject, aiMesh* aiMesh, const aiScene* scene);
 
-    vector<Texture> loadMaterialTextures(aiMaterial* mat, aiTextureType type, string typeName);
-    Texture GetOrLoadTexture(const string& fullPath, const string& fileName, const string& typeName);
-    void AssignDefaultTexture(std::vector<Texture>& textures);
+    vector<TextureHandle> loadMaterialTextures(aiMaterial* mat, aiTextureType type, string typeName);
+    TextureHandle GetOrLoadTexture(const string& fullPath, const string& fileName, const string& typeName);
+    void AssignDefaultTexture(std::vector<TextureHandle>& textures);
 
     void LogGameObjectHierarchy(std::shared_ptr<GameObject>  go, int depth);
 
-    void DestroyGameObject(std::shared_ptr<GameObject> gameObject);
-    void CleanUpDestroyedObjects();
     std::shared_ptr<GameObject> CreateEmptyGameObject(const std::string& name, std::shared_ptr<GameObject> parent = nullptr);
 
 };
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "ModelFormat.h"
+#include "Mesh.h"
+#include <fstream>
+#include <algorithm>
+
+static_assert(sizeof(ModelFormat::Header) % 8 == 0, "Header must keep 64-bit offsets aligned");
+static_assert(sizeof(ModelFormat::MeshEntry) % 8 == 0, "Mesh table entries must keep 64-bit offsets aligned");
+
+namespace ModelFormat {
+
+    using MeshFormat::Align;
+
+    uint32_t Package::AddString(const std::string& value) {
+        uint32_t offset = (uint32_t)strings.size();
+        strings.append(value);
+        strings.push_back('\0');
+        return offset;
+    }
+
+    static void Pad(std::ostream& out, uint64_t& written, uint64_t target) {
+        static const char zeros[MeshFormat::SECTION_ALIGNMENT] = {};
+        while (written < target) {
+            uint64_t chunk = std::min<uint64_t>(target - written, MeshFormat::SECTION_ALIGNMENT);
+            out.write(zeros, (std::streamsize)chunk);
+            written += chunk;
+        }
+    }
+
+    template <typename T>
+    static void WriteSection(std::ostream& out, uint64_t& written, uint64_t offset, const std::vector<T>& items) {
+        Pad(out, written, offset);
+        if (!items.empty()) out.write((const char*)items.data(), (std::streamsize)(items.size() * sizeof(T)));
+        written += items.size() * sizeof(T);
+    }
+
+    bool Write(std::ostream& out, const Package& package) {
+        Header header = {};
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.meshCount = (uint32_t)package.meshes.size();
+        header.nodeCount = (uint32_t)package.nodes.size();
+        header.nodeMeshCount = (uint32_t)package.nodeMeshes.size();
+        header.materialCount = (uint32_t)package.materials.size();
+        header.textureCount = (uint32_t)package.textures.size();
+        header.stringTableSize = (uint32_t)package.strings.size();
+
+        header.meshesOffset = Align(sizeof(Header));
+        header.nodesOffset = Align(header.meshesOffset + (uint64_t)header.meshCount * sizeof(MeshEntry));
+        header.nodeMeshesOffset = Align(header.nodesOffset + (uint64_t)header.nodeCount * sizeof(Node));
+        header.materialsOffset = Align(header.nodeMeshesOffset + (uint64_t)header.nodeMeshCount * sizeof(uint32_t));
+        header.texturesOffset = Align(header.materialsOffset + (uint64_t)header.materialCount * sizeof(Material));
+        header.stringsOffset = Align(header.texturesOffset + (uint64_t)header.textureCount * sizeof(TextureRef));
+
+        // Mesh blobs go after the tables, each one aligned like a standalone VMSH file
+        std::vector<MeshEntry> entries(package.meshes.size());
+        uint64_t cursor = Align(header.stringsOffset + header.stringTableSize);
+        for (size_t i = 0; i < package.meshes.size(); ++i) {
+            const SourceMesh& mesh = package.meshes[i];
+            MeshEntry& entry = entries[i];
+            entry.nameOffset = mesh.nameOffset;
+            entry.flags = mesh.skipped ? MESH_SKIPPED : MESH_NONE;
+            entry.materialIndex = mesh.materialIndex;
+            entry.reserved = 0;
+            entry.blobOffset = cursor;
+            entry.blobSize = mesh.skipped ? 0 : MeshFormat::ComputeSize((uint32_t)mesh.vertices.size(), (uint32_t)mesh.indices.size(), 1);
+            cursor = Align(cursor + entry.blobSize);
+        }
+        header.totalSize = cursor;
+
+        uint64_t written = 0;
+        out.write((const char*)&header, sizeof(Header));
+        written += sizeof(Header);
+
+        WriteSection(out, written, header.meshesOffset, entries);
+        WriteSection(out, written, header.nodesOffset, package.nodes);
+        WriteSection(out, written, header.nodeMeshesOffset, package.nodeMeshes);
+        WriteSection(out, written, header.materialsOffset, package.materials);
+        WriteSection(out, written, header.texturesOffset, package.textures);
+
+        Pad(out, written, header.stringsOffset);
+        out.write(package.strings.data(), (std::streamsize)package.strings.size());
+        written += package.strings.size();
+
+        for (size_t i = 0; i < package.meshes.size(); ++i) {
+            const SourceMesh& mesh = package.meshes[i];
+            if (mesh.skipped) continue;
+
+            Pad(out, written, entries[i].blobOffset);
+            MeshFormat::SubMesh subMesh = { 0, (uint32_t)mesh.indices.size(), 0, mesh.materialIndex };
+            if (!MeshFormat::Write(out, mesh.vertices.data(), (uint32_t)mesh.vertices.size(),
+                mesh.indices.data(), (uint32_t)mesh.indices.size(), &subMesh, 1, mesh.meshFlags)) {
+                return false;
+            }
+            written += entries[i].blobSize;
+        }
+
+        Pad(out, written, header.totalSize);
+        return out.good();
+    }
+
+    static bool SectionFits(uint64_t offset, uint64_t bytes, uint64_t size) {
+        return offset % MeshFormat::SECTION_ALIGNMENT == 0 && offset <= size && bytes <= size - offset;
+    }
+
+    bool Parse(const uint8_t* data, size_t size, View& view) {
+        if (data == nullptr || size < sizeof(Header)) return false;
+
+        const Header* header = reinterpret_cast<const Header*>(data);
+        if (header->magic != MAGIC || header->version != VERSION) return false;
+        if (header->totalSize > size) return false;
+
+        uint64_t total = header->totalSize;
+        if (!SectionFits(header->meshesOffset, (uint64_t)header->meshCount * sizeof(MeshEntry), total) ||
+            !SectionFits(header->nodesOffset, (uint64_t)header->nodeCount * sizeof(Node), total) ||
+            !SectionFits(header->nodeMeshesOffset, (uint64_t)header->nodeMeshCount * sizeof(uint32_t), total) ||
+            !SectionFits(header->materialsOffset, (uint64_t)header->materialCount * sizeof(Material), total) ||
+            !SectionFits(header->texturesOffset, (uint64_t)header->textureCount * sizeof(TextureRef), total) ||
+            !SectionFits(header->stringsOffset, header->stringTableSize, total)) {
+            return false;
+        }
+
+        view.header = header;
+        view.meshes = reinterpret_cast<const MeshEntry*>(data + header->meshesOffset);
+        view.nodes = reinterpret_cast<const Node*>(data + header->nodesOffset);
+        view.nodeMeshes = reinterpret_cast<const uint32_t*>(data + header->nodeMeshesOffset);
+        view.materials = reinterpret_cast<const Material*>(data + header->materialsOffset);
+        view.textures = reinterpret_cast<const TextureRef*>(data + header->texturesOffset);
+        view.strings = reinterpret_cast<const char*>(data + header->stringsOffset);
+
+        // Index ranges have to stay inside their tables, the loader trusts them afterwards
+        for (uint32_t i = 0; i < header->meshCount; ++i) {
+            const MeshEntry& entry = view.meshes[i];
+            if (entry.flags & MESH_SKIPPED) continue;
+            if (!SectionFits(entry.blobOffset, entry.blobSize, total)) return false;
+        }
+        for (uint32_t i = 0; i < header->nodeCount; ++i) {
+            const Node& node = view.nodes[i];
+            if (node.parent != NO_PARENT && (node.parent < 0 || (uint32_t)node.parent >= i)) return false;
+            if ((uint64_t)node.firstMesh + node.meshCount > header->nodeMeshCount) return false;
+        }
+        for (uint32_t i = 0; i < header->nodeMeshCount; ++i) {
+            if (view.nodeMeshes[i] >= header->meshCount) return false;
+        }
+        for (uint32_t i = 0; i < header->materialCount; ++i) {
+            const Material& material = view.materials[i];
+            if ((uint64_t)material.firstTexture + material.textureCount > header->textureCount) return false;
+        }
+        if (header->stringTableSize > 0 && view.strings[header->stringTableSize - 1] != '\0') return false;
+
+        return true;
+    }
+
+    bool IsCurrent(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+
+        Header header = {};
+        if (!file.read((char*)&header, sizeof(Header))) return false;
+
+        return header.magic == MAGIC && header.version == VERSION;
+    }
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <ostream>
+#include "MeshFormat.h"
+
+struct Vertex;
+
+// Binary layout of a whole imported scene (fbx/obj) stored in Assets/Library.
+//
+//   [Header][Mesh table][Node table][Node mesh indices][Materials][Texture refs][Strings][VMSH blob 0][VMSH blob 1]...
+//
+// Each mesh is a complete MeshFormat blob embedded in the package, so the
+// loader maps the file once and every Mesh reads its vertices straight from
+// that mapping. Nodes are stored parent-before-child (depth first) with the
+// transform already decomposed, which is all Model needs to rebuild the
+// GameObject hierarchy without calling Assimp.
+namespace ModelFormat {
+
+    constexpr uint32_t MAGIC = 0x4C444D56; // "VMDL"
+    constexpr uint32_t VERSION = 1;
+    constexpr int32_t NO_PARENT = -1;
+
+    enum MeshFlags : uint32_t {
+        MESH_NONE = 0,
+        MESH_SKIPPED = 1 << 0 // lines/points, kept in the table so scene mesh indices still match
+    };
+
+    enum MaterialFlags : uint32_t {
+        MATERIAL_NONE = 0,
+        MATERIAL_HAS_DIFFUSE_COLOR = 1 << 0,
+        MATERIAL_HAS_SHININESS = 1 << 1
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t meshCount;
+        uint32_t nodeCount;
+        uint32_t nodeMeshCount;
+        uint32_t materialCount;
+        uint32_t textureCount;
+        uint32_t stringTableSize;
+        uint64_t meshesOffset;
+        uint64_t nodesOffset;
+        uint64_t nodeMeshesOffset;
+        uint64_t materialsOffset;
+        uint64_t texturesOffset;
+        uint64_t stringsOffset;
+        uint64_t totalSize;
+    };
+
+    struct MeshEntry {
+        uint64_t blobOffset;     // absolute offset of the VMSH blob in the package
+        uint64_t blobSize;
+        uint32_t nameOffset;
+        uint32_t flags;
+        uint32_t materialIndex;
+        uint32_t reserved;
+    };
+
+    struct Node {
+        uint32_t nameOffset;
+        int32_t parent;          // index into the node table, NO_PARENT for the scene root
+        uint32_t firstMesh;      // range inside the node mesh index section
+        uint32_t meshCount;
+        float position[3];
+        float rotation[4];       // w, x, y, z (same order as glm::quat's constructor)
+        float scale[3];
+        uint32_t reserved;
+    };
+
+    struct Material {
+        float diffuseColor[4];
+        float shininess;
+        uint32_t flags;
+        uint32_t firstTexture;
+        uint32_t textureCount;
+    };
+
+    struct TextureRef {
+        uint32_t fileNameOffset; // file name only, resolved next to the model like the Assimp path does
+        uint32_t typeNameOffset; // "texture_diffuse", "texture_normal"...
+    };
+
+    struct View {
+        const Header* header = nullptr;
+        const MeshEntry* meshes = nullptr;
+        const Node* nodes = nullptr;
+        const uint32_t* nodeMeshes = nullptr;
+        const Material* materials = nullptr;
+        const TextureRef* textures = nullptr;
+        const char* strings = nullptr;
+
+        const char* GetString(uint32_t offset) const {
+            return offset < header->stringTableSize ? strings + offset : "";
+        }
+    };
+
+    // Everything the importer collected, before it is laid out on disk
+    struct SourceMesh {
+        uint32_t nameOffset = 0;
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        uint32_t meshFlags = MeshFormat::FLAG_NONE;
+        uint32_t materialIndex = 0;
+        bool skipped = false;
+    };
+
+    struct Package {
+        std::vector<SourceMesh> meshes;
+        std::vector<Node> nodes;
+        std::vector<uint32_t> nodeMeshes;
+        std::vector<Material> materials;
+        std::vector<TextureRef> textures;
+        std::string strings;
+
+        // Appends a null terminated string and returns its offset in the table
+        uint32_t AddString(const std::string& value);
+    };
+
+    bool Write(std::ostream& out, const Package& package);
+
+    // Validates the package tables and every embedded mesh blob
+    bool Parse(const uint8_t* data, size_t size, View& view);
+
+    bool IsCurrent(const std::string& path);
+}
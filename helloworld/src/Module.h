@@ -41,6 +41,12 @@ public:
 		return true;
 	}
 
+	// Called 0..n times per loop iteration, before Update, at a constant rate (FrameClock::fixedHz)
+	virtual bool FixedUpdate(float fixedDt)
+	{
+		return true;
+	}
+
 	// Called each loop iteration
 	virtual bool Update(float dt)
 	{
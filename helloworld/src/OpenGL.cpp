@@ -12,11 +12,15 @@
 #include "GUIManager.h"
 #include "CameraComponent.h"
 #include "TransformComponent.h"
+#include "TransformSystem.h"
 #include "GameObject.h"
+#include "Profiler.h"
+#include "ShaderManager.h"
 
 OpenGL::OpenGL() : Module()
 {
 	std::cout << "OpenGL Constructor" << std::endl;
+	name = "openGL";
 	VAO = 0;
 	VBO = 1;
 	EBO = 2;
@@ -40,7 +44,8 @@ bool OpenGL::Start() {
 	projectionMat = Application::GetInstance().camera->projectionMat;
 
 	// AQUI ESTA EL CAMBIO DE LA RUTA RELATIVA
-	texCoordsShader = new Shader("Assets/Shaders/TexCoordsShader.vert", "Assets/Shaders/TexCoordsShader.frag");
+	//from the Library binary when the sources didn't change since the last run
+	texCoordsShader = ShaderManager::GetInstance().Load("Assets/Shaders/TexCoordsShader.vert", "Assets/Shaders/TexCoordsShader.frag");
 
 	std::cout << "OpenGL initialized successfully" << std::endl;
 
@@ -48,24 +53,19 @@ bool OpenGL::Start() {
 	modelMat = glm::rotate(modelMat, glm::radians(45.0f), glm::vec3(0.0f, -1.0f, 0.0f));
 
 	texCoordsShader->Use();
-	uint modelMatLoc = glad_glGetUniformLocation(texCoordsShader->ID, "model");
-	glUniformMatrix4fv(modelMatLoc, 1, GL_FALSE, glm::value_ptr(modelMat));
+	texCoordsShader->setMat4("model", modelMat);
 
 	viewMat = glm::mat4(1.0f);
 	viewMat = glm::translate(viewMat, glm::vec3(0.0f, -2.0f, -15.0f));
 
-	texCoordsShader->Use();
-	uint viewMatLoc = glad_glGetUniformLocation(texCoordsShader->ID, "view");
-	glUniformMatrix4fv(viewMatLoc, 1, GL_FALSE, glm::value_ptr(viewMat));
-
 	int windowW, windowH;
 	Application::GetInstance().window.get()->GetSize(windowW, windowH);
 
 	projectionMat = glm::mat4(1.0f);
 	projectionMat = glm::perspective(glm::radians(45.0f), (float)windowW / windowH, 0.1f, 100.0f);
-	texCoordsShader->Use();
-	uint projectionMatLoc = glad_glGetUniformLocation(texCoordsShader->ID, "projection");
-	glUniformMatrix4fv(projectionMatLoc, 1, GL_FALSE, glm::value_ptr(projectionMat));
+
+	//view / projection live in the Camera uniform block, shared by every program
+	cameraUniforms.Upload(viewMat, projectionMat);
 
 	glEnable(GL_DEPTH_TEST);
 
@@ -89,7 +89,7 @@ bool OpenGL::Start() {
 
 	camGO->AddComponent(ComponentType::CAMERA);
 
-	auto transform = std::dynamic_pointer_cast<TransformComponent>(camGO->GetComponent(ComponentType::TRANSFORM));
+	auto transform = camGO->GetComponent<TransformComponent>();
 	if (transform)
 	{
 		transform->SetPosition(glm::vec3(0.0f, 3.0f, 10.0f));
@@ -102,6 +102,9 @@ bool OpenGL::Start() {
 
 bool OpenGL::Update(float dt)
 {
+	//frame boundary: reloaded programs are swapped in before anything is extracted with them
+	ShaderManager::GetInstance().Update(dt);
+
 	glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -125,30 +128,88 @@ bool OpenGL::Update(float dt)
 		projectionMat = Application::GetInstance().camera->projectionMat;
 	}
 
-	glUseProgram(texCoordsShader->ID);
+	//checker texture swaps go through the texture cache: main thread, before extraction
+	for (Model* model : Application::GetInstance().render.get()->modelsToDraw) {
+		model->UpdateDefaultTexture();
+	}
+
+	RenderQueue& queue = Application::GetInstance().render->renderQueue;
+	if (pipelinedFrames) {
+		//the worker extracts this frame while the one extracted last frame is drawn;
+		//WaitForFrame (Application::FinishUpdate) publishes it before the scene can change again
+		if (!queue.HasFrame()) {
+			ExtractFrame(viewMat, projectionMat, queue.settings);
+			queue.Publish();
+		}
+		//camera and GUI toggles copied here: the worker never reads what the main thread edits
+		glm::mat4 view = viewMat;
+		glm::mat4 projection = projectionMat;
+		RenderQueue::Settings settings = queue.settings;
+		framePipeline.Kick([this, view, projection, settings]() { ExtractFrame(view, projection, settings); });
+	}
+	else {
+		ExtractFrame(viewMat, projectionMat, queue.settings);
+		queue.Publish();
+	}
 
-	texCoordsShader->setMat4("view", viewMat);
-	texCoordsShader->setMat4("projection", projectionMat);
+	SubmitFrame();
 
-	glm::mat4 identity = glm::mat4(1.0f);
-	texCoordsShader->setMat4("model", identity);
+	return true;
+}
 
-	glUniform1i(glGetUniformLocation(texCoordsShader->ID, "useLineColor"), true);
-	glUniform4f(glGetUniformLocation(texCoordsShader->ID, "lineColor"), 0.5f, 0.5f, 0.5f, 1.0f);
+void OpenGL::ExtractFrame(const glm::mat4& view, const glm::mat4& projection, const RenderQueue::Settings& settings) {
+	PROFILE_SCOPE("ExtractFrame");
 
-	Application::GetInstance().render.get()->DrawGrid();
+	//world matrices of everything that moved, parents before children, in one pass
+	TransformSystem::GetInstance().Update();
 
-	glUniform1i(glGetUniformLocation(texCoordsShader->ID, "useLineColor"), false);
+	//refit the leaves of whatever moved since last frame
+	sceneBVH->Update();
 
-	for (int i = 0; i < Application::GetInstance().render.get()->modelsToDraw.size(); i++) {
-		Application::GetInstance().render.get()->modelsToDraw[i]->Draw(*texCoordsShader);
+	RenderQueue& queue = Application::GetInstance().render->renderQueue;
+	queue.Begin(view, projection, settings);
+	for (Model* model : Application::GetInstance().render.get()->modelsToDraw) {
+		model->CollectDrawItems(queue, texCoordsShader->ID);
 	}
+	queue.End();
+}
 
-	return true;
+void OpenGL::SubmitFrame() {
+	PROFILE_SCOPE("SubmitFrame");
+	RenderQueue& queue = Application::GetInstance().render->renderQueue;
+
+	//camera the snapshot was extracted with (one frame behind in pipelined mode),
+	//uploaded once for the meshes, the debug lines and any other program
+	cameraUniforms.Upload(queue.GetFrameView(), queue.GetFrameProjection());
+
+	glUseProgram(texCoordsShader->ID);
+	queue.Submit(*texCoordsShader);
+
+	//grid, selection boxes and normals: one batch, after the meshes
+	Render* render = Application::GetInstance().render.get();
+	render->DrawGrid();
+	queue.AddDebugLines(render->debugDraw);
+	render->debugDraw.Flush();
+}
+
+void OpenGL::WaitForFrame() {
+	if (!framePipeline.IsRunning())
+		return;
+
+	PROFILE_SCOPE("WaitForFrame");
+	framePipeline.Wait();
+	Application::GetInstance().render->renderQueue.Publish();
 }
 
 bool OpenGL::CleanUp() {
+	framePipeline.Stop();
 	glDeleteVertexArrays(1, &VAO);
+	Application::GetInstance().render->renderQueue.Release();
+	Application::GetInstance().render->debugDraw.Release();
+	Application::GetInstance().render->gridLines.Release();
+	cameraUniforms.Release();
+	ShaderManager::GetInstance().CleanUp();
+	texCoordsShader = nullptr;
 	return true;
 }
 
@@ -164,7 +225,7 @@ Model* OpenGL::CreateCube() {
 
 	std::vector<Vertex> _vertices;
 	std::vector<unsigned int> _indices;
-	std::vector<Texture> _textures;
+	std::vector<TextureHandle> _textures;
 
 	const glm::vec3 normals[6] = {
 		glm::vec3(0.0f, 0.0f, 1.0f),
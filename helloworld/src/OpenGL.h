@@ -4,6 +4,11 @@
 
 #include "Model.h"
 #include "CameraComponent.h"
+#include "SceneBVH.h"
+#include "DestructionQueue.h"
+#include "FramePipeline.h"
+#include "RenderQueue.h"
+#include <memory>
 
 class OpenGL : public Module {
 
@@ -22,16 +27,33 @@ public:
 	glm::mat4 modelMat, viewMat, projectionMat;
 	glm::vec3* cubePositions = new glm::vec3[10];
 
-	Shader* texCoordsShader;
+	Shader* texCoordsShader;    // owned by ShaderManager
+	// view / projection of the frame being drawn, read by every program through the Camera block
+	CameraUniforms cameraUniforms;
 	Model* ourModel;
 	vector<Model*> modelObjects;
 	bool useGameCamera = false;
 	CameraComponent* gameCamera = nullptr;
+	// world AABBs of every mesh renderer, for picking and other scene queries
+	std::shared_ptr<SceneBVH> sceneBVH = std::make_shared<SceneBVH>();
+	// GameObject subtrees deleted this frame, released in Application::FinishUpdate
+	std::shared_ptr<DestructionQueue> destructionQueue = std::make_shared<DestructionQueue>();
+	// Extract the render list of frame N+1 on a worker while frame N is submitted (1 frame of latency)
+	bool pipelinedFrames = false;
+	FramePipeline framePipeline;
 
 
 	bool Start() override;
 	bool Update(float dt) override;
 	bool CleanUp() override;
 
+	// Scene update + render list extraction into the queue snapshot being built. No GL calls.
+	// Everything it reads from the main thread state is copied in by the caller
+	void ExtractFrame(const glm::mat4& view, const glm::mat4& projection, const RenderQueue::Settings& settings);
+	// Grid + the published snapshot, main thread
+	void SubmitFrame();
+	// End of frame: joins the pipelined extraction and publishes its snapshot
+	void WaitForFrame();
+
 	Model* CreateCube();
 };
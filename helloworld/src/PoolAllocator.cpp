@@ -0,0 +1,88 @@
+#include "PoolAllocator.h"
+#include <new>
+
+bool PoolArena::enabled = true;
+PoolArena::Stats PoolArena::globalStats;
+
+static thread_local std::shared_ptr<PoolArena> currentArena;
+
+PoolArena::~PoolArena() {
+    // bulk release: blocks still on the free lists live inside these slabs
+    for (void* slab : slabs)
+        ::operator delete(slab);
+    globalStats.slabBytes -= stats.slabBytes;
+}
+
+std::shared_ptr<PoolArena> PoolArena::GetCurrent() {
+    if (currentArena)
+        return currentArena;
+
+    // objects created outside any model (scene root, editor created objects...)
+    static std::shared_ptr<PoolArena>* defaultArena = new std::shared_ptr<PoolArena>(std::make_shared<PoolArena>());
+    return *defaultArena;
+}
+
+void* PoolArena::Allocate(size_t size, size_t alignment) {
+    stats.allocations++;
+    globalStats.allocations++;
+
+    if (size == 0) size = 1;
+    if (size > MaxBlockSize || alignment > Granularity) {
+        stats.heapAllocations++;
+        globalStats.heapAllocations++;
+        return ::operator new(size);
+    }
+
+    size_t sizeClass = (size - 1) / Granularity;
+    if (!freeLists[sizeClass])
+        Refill(sizeClass);
+
+    FreeBlock* block = freeLists[sizeClass];
+    freeLists[sizeClass] = block->next;
+    return block;
+}
+
+void PoolArena::Deallocate(void* pointer, size_t size, size_t alignment) {
+    if (!pointer) return;
+    stats.frees++;
+    globalStats.frees++;
+
+    if (size == 0) size = 1;
+    if (size > MaxBlockSize || alignment > Granularity) {
+        ::operator delete(pointer);
+        return;
+    }
+
+    size_t sizeClass = (size - 1) / Granularity;
+    FreeBlock* block = static_cast<FreeBlock*>(pointer);
+    block->next = freeLists[sizeClass];
+    freeLists[sizeClass] = block;
+}
+
+// One slab carved entirely into blocks of the class
+void PoolArena::Refill(size_t sizeClass) {
+    size_t blockSize = (sizeClass + 1) * Granularity;
+    char* slab = static_cast<char*>(::operator new(SlabSize));
+    slabs.push_back(slab);
+
+    stats.heapAllocations++;
+    stats.slabBytes += SlabSize;
+    globalStats.heapAllocations++;
+    globalStats.slabBytes += SlabSize;
+
+    size_t blockCount = SlabSize / blockSize;
+    for (size_t i = blockCount; i-- > 0;) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + i * blockSize);
+        block->next = freeLists[sizeClass];
+        freeLists[sizeClass] = block;
+    }
+}
+
+ArenaScope::ArenaScope(std::shared_ptr<PoolArena> arena)
+    : previous(currentArena) {
+    currentArena = std::move(arena);
+}
+
+ArenaScope::~ArenaScope() {
+    currentArena = std::move(previous);
+}
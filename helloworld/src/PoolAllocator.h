@@ -0,0 +1,106 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+// Slab arena for the small, numerous objects of a scene (GameObjects,
+// components and their shared_ptr control blocks).
+//
+// Requests up to MaxBlockSize are served from size-class free lists carved
+// out of 64 KB slabs, so importing a model with thousands of nodes costs a
+// handful of heap calls instead of one per object, and objects of the same
+// model end up next to each other. Freed blocks go back to their free list;
+// the slabs themselves are released together when the arena dies, which is
+// once its Model and every object allocated from it are gone (the allocator
+// inside each control block keeps the arena alive).
+//
+// Main thread only.
+class PoolArena {
+public:
+    struct Stats {
+        uint64_t allocations = 0;       // served by this arena (pooled or not)
+        uint64_t frees = 0;
+        uint64_t heapAllocations = 0;   // slabs + oversized requests
+        size_t slabBytes = 0;
+    };
+
+    PoolArena() = default;
+    ~PoolArena();
+    PoolArena(const PoolArena&) = delete;
+    PoolArena& operator=(const PoolArena&) = delete;
+
+    void* Allocate(size_t size, size_t alignment);
+    void Deallocate(void* pointer, size_t size, size_t alignment);
+
+    const Stats& GetStats() const { return stats; }
+
+    // Arena used by MakePooled: the innermost ArenaScope, or a shared default one
+    static std::shared_ptr<PoolArena> GetCurrent();
+
+    // Every arena plus the plain make_shared calls made while pooling is disabled
+    static const Stats& GetGlobalStats() { return globalStats; }
+
+    // Off = MakePooled falls back to make_shared (one heap call per object), for comparisons
+    static bool enabled;
+    static void CountUnpooledAllocation() { globalStats.allocations++; globalStats.heapAllocations++; }
+
+private:
+    friend class ArenaScope;
+
+    struct FreeBlock { FreeBlock* next; };
+
+    static constexpr size_t Granularity = 16;
+    static constexpr size_t MaxBlockSize = 512;
+    static constexpr size_t SlabSize = 64 * 1024;
+    static constexpr size_t ClassCount = MaxBlockSize / Granularity;
+
+    void Refill(size_t sizeClass);
+
+    FreeBlock* freeLists[ClassCount] = {};
+    std::vector<void*> slabs;
+    Stats stats;
+
+    static Stats globalStats;
+};
+
+// Makes MakePooled allocate from the given arena until the scope ends
+class ArenaScope {
+public:
+    explicit ArenaScope(std::shared_ptr<PoolArena> arena);
+    ~ArenaScope();
+
+private:
+    std::shared_ptr<PoolArena> previous;
+};
+
+// Standard allocator over a PoolArena, holds a reference so the arena outlives every block
+template<typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    explicit PoolAllocator(std::shared_ptr<PoolArena> arena) : arena(std::move(arena)) {}
+    template<typename U> PoolAllocator(const PoolAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t count) { return static_cast<T*>(arena->Allocate(count * sizeof(T), alignof(T))); }
+    void deallocate(T* pointer, size_t count) { arena->Deallocate(pointer, count * sizeof(T), alignof(T)); }
+
+    template<typename U> bool operator==(const PoolAllocator<U>& other) const { return arena == other.arena; }
+    template<typename U> bool operator!=(const PoolAllocator<U>& other) const { return arena != other.arena; }
+
+private:
+    template<typename U> friend class PoolAllocator;
+    std::shared_ptr<PoolArena> arena;
+};
+
+// make_shared replacement: object and control block in one block of the current arena
+template<typename T, typename... Args>
+std::shared_ptr<T> MakePooled(Args&&... args) {
+    if (!PoolArena::enabled) {
+        PoolArena::CountUnpooledAllocation();
+        return std::make_shared<T>(std::forward<Args>(args)...);
+    }
+    return std::allocate_shared<T>(PoolAllocator<T>(PoolArena::GetCurrent()), std::forward<Args>(args)...);
+}
@@ -0,0 +1,161 @@
+#include "Profiler.h"
+#include "Log.h"
+#include <chrono>
+#include <fstream>
+#include <algorithm>
+#include <nlohmann/json.hpp>
+
+namespace {
+    // events a thread keeps while no frame collects them (loading before the first frame)
+    constexpr size_t MAX_PENDING_EVENTS = 1 << 16;
+
+    const std::chrono::steady_clock::time_point profilerStart = std::chrono::steady_clock::now();
+}
+
+Profiler& Profiler::GetInstance() {
+    // never destroyed: worker threads may still close scopes during static destruction
+    static Profiler* instance = new Profiler();
+    return *instance;
+}
+
+Profiler::Profiler() {
+    frames.resize(FRAME_HISTORY);
+    frameStart = Now();
+}
+
+int64_t Profiler::Now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - profilerStart).count();
+}
+
+Profiler::ThreadEvents& Profiler::GetThreadEvents() {
+    // flags the buffer when the thread ends; NewFrame collects its last events and drops it
+    struct Registration {
+        std::shared_ptr<ThreadEvents> events;
+        ~Registration() { if (events) events->exited = true; }
+    };
+    thread_local Registration registration;
+    if (registration.events)
+        return *registration.events;
+
+    auto created = std::make_shared<ThreadEvents>();
+    {
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        created->index = nextThreadIndex++;
+        threads.push_back(created);
+    }
+    registration.events = created;
+    return *created;
+}
+
+size_t Profiler::GetThreadCount() {
+    std::lock_guard<std::mutex> lock(threadsMutex);
+    return nextThreadIndex;
+}
+
+void Profiler::BeginScope(const char* name) {
+    ThreadEvents& thread = GetThreadEvents();
+    thread.starts.push_back(Now());
+    thread.stack.push_back(name);
+}
+
+void Profiler::EndScope() {
+    ThreadEvents& thread = GetThreadEvents();
+    if (thread.stack.empty())
+        return;
+
+    Event event;
+    event.end = Now();
+    event.start = thread.starts.back();
+    event.name = thread.stack.back();
+    thread.starts.pop_back();
+    thread.stack.pop_back();
+    event.parent = thread.stack.empty() ? nullptr : thread.stack.back();
+    event.depth = (uint16_t)thread.stack.size();
+    event.thread = thread.index;
+
+    std::lock_guard<std::mutex> lock(thread.mutex);
+    if (thread.events.size() < MAX_PENDING_EVENTS)
+        thread.events.push_back(event);
+}
+
+void Profiler::NewFrame() {
+    mainThread = GetThreadEvents().index;
+
+    int64_t now = Now();
+
+    std::vector<std::shared_ptr<ThreadEvents>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        snapshot = threads;
+        // finished threads (benchmark workers...) after this last collection
+        threads.erase(std::remove_if(threads.begin(), threads.end(),
+            [](const std::shared_ptr<ThreadEvents>& thread) { return thread->exited.load(); }), threads.end());
+    }
+
+    if (paused || !enabled) {
+        for (auto& thread : snapshot) {
+            std::lock_guard<std::mutex> lock(thread->mutex);
+            thread->events.clear();
+        }
+        frameStart = now;
+        return;
+    }
+
+    // reuse the slot's vector, the ring stops allocating once warmed up
+    Frame& frame = frames[head];
+    frame.index = frameIndex++;
+    frame.start = frameStart;
+    frame.end = now;
+    frame.events.clear();
+    for (auto& thread : snapshot) {
+        std::lock_guard<std::mutex> lock(thread->mutex);
+        frame.events.insert(frame.events.end(), thread->events.begin(), thread->events.end());
+        thread->events.clear();
+    }
+
+    head = (head + 1) % FRAME_HISTORY;
+    if (frameCount < FRAME_HISTORY)
+        frameCount++;
+    frameStart = now;
+}
+
+const Profiler::Frame& Profiler::GetFrame(size_t age) const {
+    size_t slot = (head + FRAME_HISTORY - 1 - (age % FRAME_HISTORY)) % FRAME_HISTORY;
+    return frames[slot];
+}
+
+bool Profiler::ExportChromeTrace(const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        LOG("Profiler: could not write %s", path.c_str());
+        return false;
+    }
+
+    nlohmann::json events = nlohmann::json::array();
+
+    size_t threadCount = GetThreadCount();
+    for (size_t t = 0; t < threadCount; ++t) {
+        events.push_back({ { "name", "thread_name" }, { "ph", "M" }, { "pid", 0 }, { "tid", t },
+            { "args", { { "name", t == mainThread ? std::string("Main") : "Worker " + std::to_string(t) } } } });
+    }
+
+    size_t eventCount = 0;
+    for (size_t age = frameCount; age-- > 0;) {
+        const Frame& frame = GetFrame(age);
+        events.push_back({ { "name", "Frame " + std::to_string(frame.index) }, { "cat", "frame" }, { "ph", "X" },
+            { "ts", frame.start / 1000.0 }, { "dur", (frame.end - frame.start) / 1000.0 }, { "pid", 0 }, { "tid", mainThread } });
+
+        for (const Event& event : frame.events) {
+            nlohmann::json entry = { { "name", event.name }, { "ph", "X" }, { "ts", event.start / 1000.0 },
+                { "dur", (event.end - event.start) / 1000.0 }, { "pid", 0 }, { "tid", event.thread } };
+            if (event.parent)
+                entry["args"] = { { "parent", event.parent } };
+            events.push_back(std::move(entry));
+            eventCount++;
+        }
+    }
+
+    file << nlohmann::json{ { "traceEvents", events }, { "displayTimeUnit", "ms" } }.dump();
+    LOG("Profiler: %zu frames, %zu events exported to %s", frameCount, eventCount, path.c_str());
+    return true;
+}
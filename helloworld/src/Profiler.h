@@ -0,0 +1,108 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <mutex>
+#include <memory>
+#include <cstdint>
+#include <atomic>
+
+// CPU profiler with nested scopes, recorded per thread.
+//
+// PROFILE_SCOPE("name") times the enclosing block. Names must outlive the
+// profiler (string literals, Module::name). Each scope also remembers the
+// scope it is nested in on the same thread, so "PreUpdate/input" and
+// "Update/input" average separately. Application calls NewFrame() once per
+// loop iteration: the events of every thread go into a ring of the last
+// FRAME_HISTORY frames, which the Profiler panel draws as a timeline and the
+// Chrome trace export (chrome://tracing, Perfetto) writes out.
+//
+// Built without VROOM_PROFILING (CMake option) the macros expand to nothing.
+class Profiler {
+public:
+
+    static constexpr size_t FRAME_HISTORY = 240;
+
+    struct Event {
+        const char* name = nullptr;
+        const char* parent = nullptr;     // enclosing scope on the same thread, nullptr at the root
+        int64_t start = 0;                // ns since the profiler started
+        int64_t end = 0;
+        uint16_t depth = 0;
+        uint16_t thread = 0;              // see GetMainThread()
+    };
+
+    struct Frame {
+        uint64_t index = 0;
+        int64_t start = 0;
+        int64_t end = 0;
+        std::vector<Event> events;
+    };
+
+    static Profiler& GetInstance();
+
+    // Closes the frame in progress and starts the next one (main thread)
+    void NewFrame();
+
+    void BeginScope(const char* name);
+    void EndScope();
+
+    // Frames from oldest to newest, the one in progress not included
+    size_t GetFrameCount() const { return frameCount; }
+    const Frame& GetFrame(size_t age) const;      // 0 = last finished frame
+    // Thread indices handed out so far (finished threads included)
+    size_t GetThreadCount();
+    // Thread index of the caller of NewFrame
+    uint16_t GetMainThread() const { return mainThread; }
+
+    // Every recorded frame as Chrome trace events ("X" complete events in us)
+    bool ExportChromeTrace(const std::string& path);
+
+    bool enabled = true;
+    bool paused = false;                  // keep the history as it is (the panel can inspect it)
+
+private:
+    Profiler();
+
+    struct ThreadEvents {
+        std::mutex mutex;
+        std::vector<Event> events;
+        std::vector<const char*> stack;   // open scopes, owner thread only
+        std::vector<int64_t> starts;
+        uint16_t index = 0;
+        std::atomic<bool> exited{ false };
+    };
+
+    ThreadEvents& GetThreadEvents();
+    int64_t Now() const;
+
+    std::mutex threadsMutex;
+    std::vector<std::shared_ptr<ThreadEvents>> threads;
+    uint16_t nextThreadIndex = 0;
+
+    std::vector<Frame> frames;
+    size_t head = 0;                      // next slot to write
+    size_t frameCount = 0;
+    uint64_t frameIndex = 0;
+    int64_t frameStart = 0;
+    uint16_t mainThread = 0;
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) { Profiler::GetInstance().BeginScope(name); }
+    ~ProfileScope() { Profiler::GetInstance().EndScope(); }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#ifdef VROOM_PROFILING
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+#define PROFILE_NEW_FRAME() Profiler::GetInstance().NewFrame()
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#define PROFILE_NEW_FRAME() ((void)0)
+#endif
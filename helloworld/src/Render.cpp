@@ -4,6 +4,7 @@
 #include "Log.h"
 #include "FileSystem.h"
 #include "Mesh.h"
+#include "Headless.h"
 
 
 
@@ -35,6 +36,10 @@ bool Render::Awake()
 	int scale = Application::GetInstance().window->GetScale();
 	SDL_Window* window = Application::GetInstance().window->window;
 
+	//headless: everything goes through GL into the offscreen framebuffer
+	if (Application::GetInstance().headless->enabled)
+		return true;
+
 	// SDL3: no flags; create default renderer and set vsync separately
 	renderer = SDL_CreateRenderer(window, nullptr);
 
@@ -70,18 +75,36 @@ bool Render::Awake()
 bool Render::Start()
 {
 	LOG("render start");
+	//headless: no SDL renderer and nothing is swapped
+	if (!renderer)
+		return true;
+
 	// back background
 	if (!SDL_GetRenderViewport(renderer, &viewport))
 	{
 		LOG("SDL_GetRenderViewport failed: %s", SDL_GetError());
 	}
+
+	// the GL context is current by now; explicit, so the driver default doesn't decide
+	SetVSync(vsync);
 	return true;
 }
 
+void Render::SetVSync(bool enable)
+{
+	if (!SDL_GL_SetSwapInterval(enable ? 1 : 0))
+	{
+		LOG("Warning: could not set the swap interval: %s", SDL_GetError());
+		return;
+	}
+	vsync = enable;
+}
+
 // Called each loop iteration
 bool Render::PreUpdate()
 {
-	SDL_RenderClear(renderer);
+	if (renderer)
+		SDL_RenderClear(renderer);
 	return true;
 }
 
@@ -96,7 +119,8 @@ bool Render::PostUpdate()
 {
 
 
-	SDL_GL_SwapWindow(Application::GetInstance().window->window);
+	if (!Application::GetInstance().headless->enabled)
+		SDL_GL_SwapWindow(Application::GetInstance().window->window);
 	return true;
 }
 
@@ -104,7 +128,8 @@ bool Render::PostUpdate()
 bool Render::CleanUp()
 {
 	LOG("Destroying SDL render");
-	SDL_DestroyRenderer(renderer);
+	if (renderer)
+		SDL_DestroyRenderer(renderer);
 	return true;
 }
 
@@ -300,22 +325,24 @@ bool Render::DrawMesh(Mesh mesh, unsigned int shaderProgram, unsigned int VAO) c
 }
 
 void Render::DrawGrid() {
-	float gridSize = 1000.0f;
-	float step = 20.0f;
-
-	glLineWidth(1.0f);
-	glBegin(GL_LINES);
-
-	for (float x = -gridSize; x <= gridSize; x += step) {
+	if (!gridLines.IsBuilt()) {
+		float gridSize = 1000.0f;
+		float step = 20.0f;
+		uint32_t color = DebugDraw::PackColor(glm::vec4(0.5f, 0.5f, 0.5f, 1.0f));
+
+		std::vector<DebugDraw::Vertex> lines;
+		for (float x = -gridSize; x <= gridSize; x += step) {
+			lines.push_back({ glm::vec3(x, 0.0f, -gridSize), color });
+			lines.push_back({ glm::vec3(x, 0.0f, gridSize), color });
+		}
 
-		glVertex3f(x, 0.0f, -gridSize);
-		glVertex3f(x, 0.0f, gridSize);
-	}
+		for (float z = -gridSize; z <= gridSize; z += step) {
+			lines.push_back({ glm::vec3(-gridSize, 0.0f, z), color });
+			lines.push_back({ glm::vec3(gridSize, 0.0f, z), color });
+		}
 
-	for (float z = -gridSize; z <= gridSize; z += step) {
-		glVertex3f(-gridSize, 0.0f, z);
-		glVertex3f(gridSize, 0.0f, z);
+		gridLines.Build(lines);
 	}
 
-	glEnd();
+	debugDraw.AddLines(gridLines, glm::mat4(1.0f));
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "Model.h"
 #include "SDL3/SDL.h"
 #include "FileSystem.h"
+#include "RenderQueue.h"
+#include "DebugDraw.h"
 #include <vector>
 
 
@@ -31,6 +33,10 @@ public:
 	// Called before quitting
 	bool CleanUp();
 
+	// Swap interval of the GL window (the frame limiter still applies on top)
+	void SetVSync(bool enable);
+	bool GetVSync() const { return vsync; }
+
 	void SetViewPort(const SDL_Rect& rect);
 	void ResetViewPort();
 
@@ -43,6 +49,7 @@ public:
 
 	void AddModel(Model* model);
 	bool DrawMesh(Mesh mesh, unsigned int shaderProgram, unsigned int VAO) const;
+	// Queues the ground grid (static lines, uploaded once) in debugDraw
 	void DrawGrid();
 
 
@@ -57,6 +64,9 @@ public:
 	SDL_Rect viewport;
 	SDL_Color background;
 	vector<Model*> modelsToDraw;
+	RenderQueue renderQueue;
+	DebugDraw debugDraw;
+	DebugDraw::LineBuffer gridLines;
 	
 
 private:
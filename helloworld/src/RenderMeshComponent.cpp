@@ -3,6 +3,10 @@
 #include "MaterialComponent.h"
 #include "GameObject.h"
 #include "Shader.h"
+#include "Frustum.h"
+#include "SceneBVH.h"
+#include "Application.h"
+#include "OpenGL.h"
 
 
 RenderMeshComponent::RenderMeshComponent(std::shared_ptr<GameObject> owner)
@@ -11,7 +15,9 @@ RenderMeshComponent::RenderMeshComponent(std::shared_ptr<GameObject> owner)
 }
 
 RenderMeshComponent::~RenderMeshComponent() {
-    
+    if (auto tree = bvh.lock())
+        tree->Remove(this);
+
     mesh = nullptr;
 }
 
@@ -33,6 +39,26 @@ void RenderMeshComponent::OnEditor() {
 
 void RenderMeshComponent::SetMesh(std::shared_ptr<Mesh> newMesh) {
     mesh = newMesh;
+
+    //first mesh: join the scene BVH
+    if (bvh.expired() && Application::GetInstance().openGL)
+        bvh = Application::GetInstance().openGL->sceneBVH;
+    MarkBoundsDirty();
+}
+
+void RenderMeshComponent::MarkBoundsDirty() {
+    if (auto tree = bvh.lock())
+        tree->MarkDirty(this);
+}
+
+const AABB& RenderMeshComponent::GetWorldAABB(const TransformComponent& transform) {
+    uint32_t version = transform.GetGlobalVersion();
+    if (version != worldAABBVersion || mesh.get() != worldAABBMesh) {
+        worldAABB = mesh ? TransformAABB(mesh->meshAABB, transform.GetGlobalTransform()) : AABB();
+        worldAABBVersion = version;
+        worldAABBMesh = mesh.get();
+    }
+    return worldAABB;
 }
 
 void RenderMeshComponent::Render(Shader* shader) {
@@ -42,13 +68,13 @@ void RenderMeshComponent::Render(Shader* shader) {
     if (!sharedOwner) return;
     // Get transform component to apply transformations
     
-    auto transform = std::dynamic_pointer_cast<TransformComponent>(sharedOwner->GetComponent(ComponentType::TRANSFORM));
+    auto transform = sharedOwner->GetComponent<TransformComponent>();
     if (!transform)
         return;
     
     
    
-    auto material = std::dynamic_pointer_cast<MaterialComponent>(sharedOwner->GetComponent(ComponentType::MATERIAL));
+    auto material = sharedOwner->GetComponent<MaterialComponent>();
     if (!material)
         return;
     
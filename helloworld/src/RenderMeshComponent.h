@@ -4,6 +4,8 @@
 #include "MaterialComponent.h"
 
 class Shader;  // Forward declaration
+class TransformComponent;
+class SceneBVH;
 
 
 class RenderMeshComponent : public Component {
@@ -19,12 +21,17 @@ public:
 
     // Mesh management
     void SetMesh(std::shared_ptr<Mesh> newMesh);
-    std::shared_ptr<Mesh>  GetMesh() const { return mesh; }
+    const std::shared_ptr<Mesh>& GetMesh() const { return mesh; }
     Mesh*  GetMeshPointer() const { return mesh.get(); }
 
     // Rendering
     void Render(Shader* shader);  
 
+    // Mesh AABB in world space, only recomputed when the transform or the mesh changes
+    const AABB& GetWorldAABB(const TransformComponent& transform);
+    // The transform (or a parent) moved: refit the scene BVH leaf on its next update
+    void MarkBoundsDirty();
+
     bool drawAABB = false;
     void ToggleAABB(bool state) { drawAABB = state; }
 
@@ -32,4 +39,14 @@ private:
     std::shared_ptr<Mesh> mesh;  // Pointer to mesh data (not owned by this component)
     bool drawFaceNormals;
     bool drawVertNormals;
+
+    AABB worldAABB;
+    uint32_t worldAABBVersion = 0;
+    const Mesh* worldAABBMesh = nullptr;
+
+    // Scene BVH leaf, managed by SceneBVH
+    friend class SceneBVH;
+    std::weak_ptr<SceneBVH> bvh;
+    int bvhProxy = -1;
+    bool bvhDirty = false;
 };
\ No newline at end of file
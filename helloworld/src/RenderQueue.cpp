@@ -0,0 +1,284 @@
+#include "RenderQueue.h"
+#include "Mesh.h"
+#include "DebugDraw.h"
+#include "Shader.h"
+#include <algorithm>
+#include <iterator>
+#include <chrono>
+#include "glm/gtc/type_ptr.hpp"
+#include "Profiler.h"
+
+using Clock = std::chrono::steady_clock;
+
+// slot N samples texture unit N, bound once per program by Shader::Reflect
+static_assert(RenderQueue::SLOT_COUNT == Shader::MATERIAL_SLOT_COUNT, "Shader::MaterialSamplers must list every slot");
+
+int RenderQueue::GetSlot(const std::string& mapType) {
+    if (mapType == "texture_diffuse") return SLOT_DIFFUSE;
+    if (mapType == "texture_specular") return SLOT_SPECULAR;
+    if (mapType == "texture_normal") return SLOT_NORMAL;
+    if (mapType == "texture_roughness") return SLOT_ROUGHNESS;
+    if (mapType == "texture_metallic") return SLOT_METALLIC;
+    if (mapType == "texture_ao") return SLOT_AO;
+    return -1;
+}
+
+void RenderQueue::Begin(const glm::mat4& view, const glm::mat4& projection, const Settings& frameSettings) {
+    buildSettings = frameSettings;
+    Snapshot& snapshot = snapshots[building];
+    snapshot.items.clear();
+    snapshot.culled = 0;
+    snapshot.published = false;
+    snapshot.view = view;
+    snapshot.projection = projection;
+    frustum.Set(projection * view);
+    beginTime = Clock::now();
+}
+
+bool RenderQueue::IsVisible(const AABB& worldBox) {
+    if (!buildSettings.frustumCulling || frustum.Intersects(worldBox))
+        return true;
+
+    snapshots[building].culled++;
+    return false;
+}
+
+void RenderQueue::Push(Mesh& mesh, GLuint program, const glm::mat4& model, bool selected) {
+    DrawItem item;
+    item.program = program;
+    item.vao = mesh.GetVAO();
+    item.indexCount = (GLsizei)mesh.GetIndexCount();
+    item.model = model;
+    item.mesh = &mesh;
+    item.selected = selected;
+
+    // only the first texture of each type is sampled by the shader (texture_xxx1)
+    for (const TextureHandle& texture : mesh.textures) {
+        int slot = GetSlot(texture.mapType);
+        if (slot >= 0 && item.textures[slot] == 0)
+            item.textures[slot] = texture.GetId();
+    }
+
+    // program | diffuse texture | vao, most expensive state change in the high bits
+    item.sortKey = ((uint64_t)(item.program & 0xFFFF) << 48)
+        | ((uint64_t)(item.textures[SLOT_DIFFUSE] & 0xFFFFFF) << 24)
+        | (uint64_t)(item.vao & 0xFFFFFF);
+
+    snapshots[building].items.push_back(item);
+}
+
+void RenderQueue::End() {
+    PROFILE_SCOPE("RenderQueue::End");
+    Snapshot& snapshot = snapshots[building];
+    if (buildSettings.sortItems) {
+        std::sort(snapshot.items.begin(), snapshot.items.end(), [](const DrawItem& a, const DrawItem& b) {
+            return a.sortKey < b.sortKey;
+        });
+    }
+
+    BuildBatches(snapshot);
+    snapshot.extractMs = std::chrono::duration<double, std::milli>(Clock::now() - beginTime).count();
+}
+
+void RenderQueue::Publish() {
+    snapshots[building].published = true;
+    std::swap(building, ready);
+}
+
+const RenderQueue::ProgramLocations& RenderQueue::GetLocations(GLuint program) {
+    for (const ProgramLocations& locations : programs) {
+        if (locations.program == program)
+            return locations;
+    }
+
+    ProgramLocations locations;
+    locations.program = program;
+    locations.model = glGetUniformLocation(program, "model");
+    locations.useLineColor = glGetUniformLocation(program, "useLineColor");
+    locations.useInstancing = glGetUniformLocation(program, "useInstancing");
+    programs.push_back(locations);
+    return programs.back();
+}
+
+void RenderQueue::ForgetProgram(GLuint program) {
+    programs.erase(std::remove_if(programs.begin(), programs.end(),
+        [program](const ProgramLocations& locations) { return locations.program == program; }), programs.end());
+}
+
+static bool SameState(const RenderQueue::DrawItem& a, const RenderQueue::DrawItem& b) {
+    return a.program == b.program && a.vao == b.vao && a.indexCount == b.indexCount
+        && std::equal(std::begin(a.textures), std::end(a.textures), std::begin(b.textures));
+}
+
+void RenderQueue::BuildBatches(Snapshot& snapshot) {
+    std::vector<DrawItem>& items = snapshot.items;
+    std::vector<Batch>& batches = snapshot.batches;
+    std::vector<glm::mat4>& instanceMatrices = snapshot.instanceMatrices;
+    batches.clear();
+    instanceMatrices.clear();
+
+    for (size_t i = 0; i < items.size();) {
+        Batch batch;
+        batch.first = i;
+        batch.count = 1;
+        while (i + batch.count < items.size() && SameState(items[i], items[i + batch.count]))
+            batch.count++;
+
+        batch.instanced = buildSettings.useInstancing && batch.count >= buildSettings.minInstances;
+        if (batch.instanced) {
+            batch.instanceOffset = instanceMatrices.size();
+            for (size_t k = 0; k < batch.count; k++)
+                instanceMatrices.push_back(items[i + k].model);
+        }
+
+        batches.push_back(batch);
+        i += batch.count;
+    }
+}
+
+void RenderQueue::UploadInstances(const Snapshot& snapshot) {
+    const std::vector<glm::mat4>& instanceMatrices = snapshot.instanceMatrices;
+    if (instanceMatrices.empty())
+        return;
+
+    if (instanceBuffer == 0)
+        glGenBuffers(1, &instanceBuffer);
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    if (instanceMatrices.size() > instanceCapacity)
+        instanceCapacity = instanceMatrices.size() + instanceMatrices.size() / 2;
+
+    // orphan last frame's storage so the driver doesn't wait on draws still reading it
+    glBufferData(GL_ARRAY_BUFFER, instanceCapacity * sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, instanceMatrices.size() * sizeof(glm::mat4), instanceMatrices.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// mat4 attribute = 4 vec4 columns at locations 3..6. Set on the mesh VAO (bound
+// by the caller) and disabled again after the draw, so Mesh::Draw never reads it
+void RenderQueue::BindInstanceAttributes(size_t instanceOffset, bool enable) {
+    const GLuint firstLocation = 3;
+
+    if (!enable) {
+        for (GLuint c = 0; c < 4; c++)
+            glDisableVertexAttribArray(firstLocation + c);
+        return;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    size_t base = instanceOffset * sizeof(glm::mat4);
+    for (GLuint c = 0; c < 4; c++) {
+        glEnableVertexAttribArray(firstLocation + c);
+        glVertexAttribPointer(firstLocation + c, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(base + c * sizeof(glm::vec4)));
+        glVertexAttribDivisor(firstLocation + c, 1);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void RenderQueue::Release() {
+    if (instanceBuffer != 0) {
+        glDeleteBuffers(1, &instanceBuffer);
+        instanceBuffer = 0;
+    }
+    instanceCapacity = 0;
+}
+
+void RenderQueue::Submit(Shader& shader) {
+    PROFILE_SCOPE("RenderQueue::Submit");
+    auto start = Clock::now();
+    const Snapshot& snapshot = snapshots[ready];
+    const std::vector<DrawItem>& items = snapshot.items;
+
+    stats = Stats();
+    stats.items = (uint32_t)items.size();
+    stats.culled = snapshot.culled;
+    stats.extractMs = snapshot.extractMs;
+    if (!snapshot.published)
+        return;
+
+    UploadInstances(snapshot);
+
+    GLuint currentProgram = 0;
+    GLuint currentVao = 0;
+    GLuint boundTextures[SLOT_COUNT] = {};
+    bool instancingOn = false;
+    const ProgramLocations* locations = nullptr;
+
+    for (const Batch& batch : snapshot.batches) {
+        const DrawItem& first = items[batch.first];
+
+        if (first.program != currentProgram) {
+            glUseProgram(first.program);
+            locations = &GetLocations(first.program);
+            glUniform1i(locations->useLineColor, false);
+            glUniform1i(locations->useInstancing, false);
+            instancingOn = false;
+
+            currentProgram = first.program;
+            stats.programSwitches++;
+        }
+
+        for (int slot = 0; slot < SLOT_COUNT; slot++) {
+            GLuint texture = first.textures[slot];
+            if (texture != 0 && texture != boundTextures[slot]) {
+                glActiveTexture(GL_TEXTURE0 + slot);
+                glBindTexture(GL_TEXTURE_2D, texture);
+                boundTextures[slot] = texture;
+                stats.textureBinds++;
+            }
+        }
+
+        if (first.vao != currentVao) {
+            glBindVertexArray(first.vao);
+            currentVao = first.vao;
+            stats.vaoBinds++;
+        }
+
+        if (batch.instanced) {
+            if (!instancingOn) {
+                glUniform1i(locations->useInstancing, true);
+                instancingOn = true;
+            }
+            BindInstanceAttributes(batch.instanceOffset, true);
+            glDrawElementsInstanced(GL_TRIANGLES, first.indexCount, GL_UNSIGNED_INT, 0, (GLsizei)batch.count);
+            BindInstanceAttributes(0, false);
+
+            stats.drawCalls++;
+            stats.instancedDraws++;
+            stats.instances += (uint32_t)batch.count;
+            continue;
+        }
+
+        if (instancingOn) {
+            glUniform1i(locations->useInstancing, false);
+            instancingOn = false;
+        }
+        for (size_t k = 0; k < batch.count; k++) {
+            glUniformMatrix4fv(locations->model, 1, GL_FALSE, glm::value_ptr(items[batch.first + k].model));
+            glDrawElements(GL_TRIANGLES, first.indexCount, GL_UNSIGNED_INT, 0);
+            stats.drawCalls++;
+        }
+    }
+
+    if (instancingOn)
+        glUniform1i(locations->useInstancing, false);
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE0); //reset texture units for the rest of the frame
+
+    stats.submitMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void RenderQueue::AddDebugLines(DebugDraw& debugDraw) const {
+    const Snapshot& snapshot = snapshots[ready];
+    if (!snapshot.published)
+        return;
+
+    for (const DrawItem& item : snapshot.items) {
+        if (item.selected)
+            debugDraw.AddAABB(item.mesh->meshAABB, item.model, glm::vec4(1.0f, 0.0f, 1.0f, 1.0f));
+        if (item.mesh->drawFaceNormals)
+            debugDraw.AddLines(item.mesh->GetFaceNormalLines(), item.model);
+        if (item.mesh->drawVertNormals)
+            debugDraw.AddLines(item.mesh->GetVertNormalLines(), item.model);
+    }
+}
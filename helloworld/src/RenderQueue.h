@@ -0,0 +1,149 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <string>
+#include <chrono>
+#include "glad/glad.h"
+#include "glm/glm.hpp"
+#include "Frustum.h"
+
+class Mesh;
+class Shader;
+class DebugDraw;
+
+// Flat list of everything visible this frame, sorted by GL state before it is drawn.
+//
+// Models push one DrawItem per mesh renderer (Model::CollectDrawItems), End()
+// sorts them by program / diffuse texture / VAO and Submit() only touches GL
+// state when it actually changes. Uniform locations and sampler units are
+// resolved once per program instead of once per object.
+//
+// Consecutive items that share the same mesh (same VAO and textures) become a
+// single glDrawElementsInstanced call; their model matrices are streamed
+// through one instance buffer per frame (TexCoordsShader.vert, locations 3-6).
+//
+// Items go into one of two frame snapshots. Begin/IsVisible/Push/End build one
+// (no GL calls, so they may run on the frame pipeline worker) while Submit draws
+// the other one, published with Publish() on the main thread.
+class RenderQueue {
+public:
+
+    // Texture unit for each material slot; the sampler uniforms are set once per program
+    enum TextureSlot {
+        SLOT_DIFFUSE = 0,
+        SLOT_SPECULAR,
+        SLOT_NORMAL,
+        SLOT_ROUGHNESS,
+        SLOT_METALLIC,
+        SLOT_AO,
+        SLOT_COUNT
+    };
+
+    struct DrawItem {
+        uint64_t sortKey = 0;
+        GLuint program = 0;
+        GLuint vao = 0;
+        GLuint textures[SLOT_COUNT] = {};
+        GLsizei indexCount = 0;
+        glm::mat4 model = glm::mat4(1.0f);
+        Mesh* mesh = nullptr;         // debug lines only (AddDebugLines)
+        bool selected = false;
+    };
+
+    struct Stats {
+        uint32_t items = 0;
+        uint32_t drawCalls = 0;
+        uint32_t programSwitches = 0;
+        uint32_t textureBinds = 0;
+        uint32_t vaoBinds = 0;
+        uint32_t instancedDraws = 0;
+        uint32_t instances = 0;       // items drawn through instanced calls
+        uint32_t culled = 0;          // rejected by IsVisible, never pushed
+        double extractMs = 0.0;       // Begin to End of the submitted snapshot (sort + batching included)
+        double submitMs = 0.0;
+    };
+
+    // Toggles of the builder. The GUI edits RenderQueue::settings on the main thread;
+    // each frame is built with the copy handed to Begin, taken before the extraction starts
+    struct Settings {
+        bool sortItems = true;        // off = draw in scene order, to compare state changes against the sorted path
+        bool useInstancing = true;
+        bool frustumCulling = true;
+        uint32_t minInstances = 2;    // smaller groups keep the per-object model uniform
+    };
+
+    // Camera of the frame being built, kept in the snapshot so Submit draws with the same one
+    void Begin(const glm::mat4& view, const glm::mat4& projection, const Settings& frameSettings);
+    // Frustum test for a world space AABB, counts the rejected ones. Call before Push
+    bool IsVisible(const AABB& worldBox);
+    void Push(Mesh& mesh, GLuint program, const glm::mat4& model, bool selected);
+    // Sorts and batches the snapshot being built, CPU only
+    void End();
+    // Main thread: the snapshot built last becomes the one Submit draws
+    void Publish();
+    void Submit(Shader& shader);
+    // Selection boxes and normals of the submitted snapshot, drawn in the debug line batch
+    void AddDebugLines(DebugDraw& debugDraw) const;
+
+    bool HasFrame() const { return snapshots[ready].published; }
+    const glm::mat4& GetFrameView() const { return snapshots[ready].view; }
+    const glm::mat4& GetFrameProjection() const { return snapshots[ready].projection; }
+    // GL objects owned by the queue (instance buffer)
+    void Release();
+    // Drops the cached uniform locations of a deleted program (the id can be reused)
+    void ForgetProgram(GLuint program);
+
+    const Stats& GetStats() const { return stats; }
+
+    Settings settings;                // main thread only
+
+    static int GetSlot(const std::string& mapType);
+
+private:
+
+    struct ProgramLocations {
+        GLuint program = 0;
+        GLint model = -1;
+        GLint useLineColor = -1;
+        GLint useInstancing = -1;
+    };
+
+    // Run of sorted items drawn with the same state
+    struct Batch {
+        size_t first = 0;
+        size_t count = 0;
+        size_t instanceOffset = 0;    // into instanceMatrices, instanced batches only
+        bool instanced = false;
+    };
+
+    // Everything Submit needs for one frame; never touched by the builder once published
+    struct Snapshot {
+        glm::mat4 view = glm::mat4(1.0f);
+        glm::mat4 projection = glm::mat4(1.0f);
+        std::vector<DrawItem> items;
+        std::vector<Batch> batches;
+        std::vector<glm::mat4> instanceMatrices;
+        uint32_t culled = 0;
+        double extractMs = 0.0;
+        bool published = false;
+    };
+
+    const ProgramLocations& GetLocations(GLuint program);
+    void BuildBatches(Snapshot& snapshot);
+    void UploadInstances(const Snapshot& snapshot);
+    void BindInstanceAttributes(size_t instanceOffset, bool enable);
+
+    // builder side
+    Frustum frustum;
+    Settings buildSettings;           // copy for the frame being built, see Begin
+    Snapshot snapshots[2];
+    int building = 0;
+    int ready = 1;
+    std::chrono::steady_clock::time_point beginTime;
+
+    // Submit side (main thread)
+    GLuint instanceBuffer = 0;
+    size_t instanceCapacity = 0;      // in matrices
+    std::vector<ProgramLocations> programs;
+    Stats stats;
+};
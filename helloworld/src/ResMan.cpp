@@ -6,6 +6,15 @@
 #include <string>
 #include "ResMan.h"
 #include "FileSystem.h"
+#include "MeshFormat.h"
+#include "ModelFormat.h"
+#include "TextureFormat.h"
+#include "Textures.h"
+#include "MappedFile.h"
+#include "JobSystem.h"
+#include "AssetMeta.h"
+#include "ContentHash.h"
+#include <chrono>
 #include "assimp/Importer.hpp"
 #include "assimp/scene.h"
 #include "assimp/postprocess.h"
@@ -13,6 +22,13 @@
 #include <algorithm>
 #include "Log.h"
 
+// Post-proceso de Assimp para modelos: forma parte de los Settings del .meta
+const unsigned int ResourceManager::ModelImportFlags = aiProcess_Triangulate | aiProcess_FlipUVs;
+
+// Subir la version cuando cambie lo que un importador escribe en Library: los assets se re-importan solos
+static const uint32_t TEXTURE_IMPORTER_VERSION = 2; // 2: VTEX (BC1/BC3/BC4 + mips)
+static const uint32_t COPY_IMPORTER_VERSION = 1;
+
 ResourceManager& ResourceManager::GetInstance() {
     static ResourceManager instance;
     return instance;
@@ -44,26 +60,29 @@ std::shared_ptr<Resource> ResourceManager::InternalLoad(const std::string& path,
 
     // 3. Gestión de Library y Carga
     if (newResource) {
-        // A) UUID
-        VroomUUID uid = GetOrCreateMeta(path);
+        // A) UUID + C) Importación si el contenido, el importador o el binario han cambiado
+        AssetMeta meta;
+        EnsureImported(path, meta);
+        VroomUUID uid = meta.uid;
 
         // B) Ruta Library
         std::string libPath = "Assets/Library/" + std::to_string(uid);
 
-        // C) Importación (Si no existe el binario, lo creamos)
-        // Usamos std::filesystem para verificar si existe de forma fiable
-        if (!std::filesystem::exists(libPath)) {
-            std::cout << "[ResMan] Generando binario propio en Library para: " << path << std::endl;
-            SaveToLibrary(path, uid);
-        }
-
         // D) Configurar y Cargar
         newResource->SetUID(uid);
         newResource->SetAssetsPath(path);
         newResource->SetLibraryPath(libPath);
 
         // Al llamar a Load(), el Mesh leerá el archivo binario que acabamos de crear en SaveToLibrary
-        newResource->Load();
+        if (!newResource->Load()) {
+            // El binario no se pudo leer (corrupto o formato viejo): re-importamos una vez
+            LOG("[ResMan] Library file for %s is unreadable, re-importing", path.c_str());
+            SaveToLibrary(path, uid);
+            if (!newResource->Load()) {
+                LOG("[ResMan] ERROR: could not load %s from Library", path.c_str());
+                return nullptr;
+            }
+        }
 
         m_resources[path] = newResource;
     }
@@ -101,7 +120,7 @@ void ResourceManager::SaveToLibrary(const std::string& assetPath, VroomUUID uid)
     std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
 
     if (extension == "fbx" || extension == "obj") {
-        ImportMesh(assetPath, libPath);
+        ImportModel(assetPath, libPath);
     }
     else if (extension == "png" || extension == "jpg" || extension == "tga" || extension == "jpeg") {
         ImportTexture(assetPath, libPath);
@@ -111,77 +130,258 @@ void ResourceManager::SaveToLibrary(const std::string& assetPath, VroomUUID uid)
     }
 }
 
-void ResourceManager::ImportMesh(const std::string& assetPath, const std::string& libPath) {
-    Assimp::Importer importer;
-    const aiScene* scene = importer.ReadFile(assetPath, aiProcess_Triangulate | aiProcess_FlipUVs);
+// Helpers del importador de modelos: convierten lo que Assimp deja en memoria al Package de ModelFormat
 
-    if (!scene || !scene->mRootNode || scene->mNumMeshes == 0) {
-        std::cerr << "[Error] Assimp no pudo cargar: " << assetPath << std::endl;
+static void CollectMesh(const aiMesh* mesh, ModelFormat::SourceMesh& out, ModelFormat::Package& package) {
+    out.nameOffset = package.AddString(mesh->mName.C_Str());
+    out.materialIndex = mesh->mMaterialIndex;
+
+    // Model ignora las mallas de lineas/puntos; se quedan en la tabla para no mover los indices
+    if (!(mesh->mPrimitiveTypes & aiPrimitiveType_TRIANGLE)) {
+        out.skipped = true;
         return;
     }
 
-    aiMesh* mesh = scene->mMeshes[0]; // Simplificación: Solo la primera malla
+    // 1. Convertimos a nuestro layout de Vertex para escribirlo en bloque
+    out.vertices.resize(mesh->mNumVertices);
+    for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
+        Vertex& vertex = out.vertices[i];
+        vertex.Position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
 
-    std::ofstream file(libPath, std::ios::binary);
-    if (file.is_open()) {
-        // 1. HEADER
-        uint32_t numVertices = mesh->mNumVertices;
-        uint32_t numIndices = 0;
-        for (unsigned int i = 0; i < mesh->mNumFaces; i++) numIndices += mesh->mFaces[i].mNumIndices;
-
-        file.write((char*)&numVertices, sizeof(uint32_t));
-        file.write((char*)&numIndices, sizeof(uint32_t));
-
-        // 2. DATA - Vertices
-        for (unsigned int i = 0; i < numVertices; i++) {
-            float pos[3] = { mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z };
-            file.write((char*)pos, sizeof(float) * 3);
-
-            float norm[3] = { 0,0,0 };
-            if (mesh->HasNormals()) {
-                norm[0] = mesh->mNormals[i].x; norm[1] = mesh->mNormals[i].y; norm[2] = mesh->mNormals[i].z;
-            }
-            file.write((char*)norm, sizeof(float) * 3);
+        vertex.Normal = glm::vec3(0.0f);
+        if (mesh->HasNormals()) {
+            vertex.Normal = glm::vec3(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z);
+        }
 
-            float tex[2] = { 0,0 };
-            if (mesh->HasTextureCoords(0)) {
-                tex[0] = mesh->mTextureCoords[0][i].x; tex[1] = mesh->mTextureCoords[0][i].y;
-            }
-            file.write((char*)tex, sizeof(float) * 2);
+        vertex.texCoord = glm::vec2(0.0f);
+        if (mesh->HasTextureCoords(0)) {
+            vertex.texCoord = glm::vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y);
         }
+    }
 
-        // 3. DATA - Indices
-        for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
-            aiFace face = mesh->mFaces[i];
-            for (unsigned int j = 0; j < face.mNumIndices; j++) {
-                uint32_t idx = face.mIndices[j];
-                file.write((char*)&idx, sizeof(uint32_t));
-            }
+    out.indices.reserve(mesh->mNumFaces * 3);
+    for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
+        const aiFace& face = mesh->mFaces[i];
+        out.indices.insert(out.indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+    }
+
+    out.meshFlags = MeshFormat::FLAG_NONE;
+    if (mesh->HasNormals()) out.meshFlags |= MeshFormat::FLAG_HAS_NORMALS;
+    if (mesh->HasTextureCoords(0)) out.meshFlags |= MeshFormat::FLAG_HAS_TEXCOORDS;
+}
+
+static void CollectMaterial(aiMaterial* material, ModelFormat::Package& package) {
+    // Mismos slots y mismo orden que Model::createComponentsForMesh
+    static const std::pair<aiTextureType, const char*> slots[] = {
+        { aiTextureType_DIFFUSE, "texture_diffuse" },
+        { aiTextureType_SPECULAR, "texture_specular" },
+        { aiTextureType_DIFFUSE_ROUGHNESS, "texture_roughness" },
+        { aiTextureType_METALNESS, "texture_metallic" },
+        { aiTextureType_NORMALS, "texture_normal" },
+        { aiTextureType_AMBIENT_OCCLUSION, "texture_ao" },
+    };
+
+    ModelFormat::Material entry = {};
+    entry.diffuseColor[0] = entry.diffuseColor[1] = entry.diffuseColor[2] = entry.diffuseColor[3] = 1.0f;
+    entry.firstTexture = (uint32_t)package.textures.size();
+
+    for (const auto& slot : slots) {
+        for (unsigned int i = 0; i < material->GetTextureCount(slot.first); i++) {
+            aiString str;
+            material->GetTexture(slot.first, i, &str);
+
+            // Solo el nombre: al cargar se busca en la carpeta del modelo
+            std::string fileName = FileSystem::GetFileName(str.C_Str());
+            ModelFormat::TextureRef ref;
+            ref.fileNameOffset = package.AddString(fileName);
+            ref.typeNameOffset = package.AddString(Model::ClassifyTextureType(fileName, slot.second));
+            package.textures.push_back(ref);
         }
+    }
+    entry.textureCount = (uint32_t)package.textures.size() - entry.firstTexture;
+
+    aiColor4D color;
+    if (AI_SUCCESS == aiGetMaterialColor(material, AI_MATKEY_COLOR_DIFFUSE, &color)) {
+        entry.diffuseColor[0] = color.r;
+        entry.diffuseColor[1] = color.g;
+        entry.diffuseColor[2] = color.b;
+        entry.diffuseColor[3] = color.a;
+        entry.flags |= ModelFormat::MATERIAL_HAS_DIFFUSE_COLOR;
+    }
+
+    float shininess;
+    if (AI_SUCCESS == aiGetMaterialFloat(material, AI_MATKEY_SHININESS, &shininess)) {
+        entry.shininess = shininess;
+        entry.flags |= ModelFormat::MATERIAL_HAS_SHININESS;
+    }
+
+    package.materials.push_back(entry);
+}
+
+// Depth first: el padre siempre queda antes que sus hijos en la tabla
+static void CollectNode(const aiNode* node, int32_t parent, ModelFormat::Package& package) {
+    ModelFormat::Node entry = {};
+    entry.nameOffset = package.AddString(node->mName.C_Str());
+    entry.parent = parent;
+
+    aiVector3D position, scaling;
+    aiQuaternion rotation;
+    node->mTransformation.Decompose(scaling, rotation, position);
+
+    entry.position[0] = position.x; entry.position[1] = position.y; entry.position[2] = position.z;
+    entry.rotation[0] = rotation.w; entry.rotation[1] = rotation.x; entry.rotation[2] = rotation.y; entry.rotation[3] = rotation.z;
+    entry.scale[0] = scaling.x; entry.scale[1] = scaling.y; entry.scale[2] = scaling.z;
+
+    entry.firstMesh = (uint32_t)package.nodeMeshes.size();
+    entry.meshCount = node->mNumMeshes;
+    package.nodeMeshes.insert(package.nodeMeshes.end(), node->mMeshes, node->mMeshes + node->mNumMeshes);
+
+    int32_t index = (int32_t)package.nodes.size();
+    package.nodes.push_back(entry);
+
+    for (unsigned int i = 0; i < node->mNumChildren; i++) {
+        CollectNode(node->mChildren[i], index, package);
+    }
+}
+
+void ResourceManager::ImportModel(const std::string& assetPath, const std::string& libPath) {
+    Assimp::Importer importer;
+    // Mismos flags que Model::loadModelWithAssimp para que el resultado sea identico
+    const aiScene* scene = importer.ReadFile(assetPath, ModelImportFlags);
+
+    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode || scene->mNumMeshes == 0) {
+        std::cerr << "[Error] Assimp no pudo cargar: " << assetPath << std::endl;
+        return;
+    }
+
+    // 1. Todas las mallas, no solo mMeshes[0]
+    ModelFormat::Package package;
+    package.meshes.resize(scene->mNumMeshes);
+    for (unsigned int i = 0; i < scene->mNumMeshes; i++) {
+        CollectMesh(scene->mMeshes[i], package.meshes[i], package);
+    }
+
+    // 2. Materiales y referencias a texturas
+    for (unsigned int i = 0; i < scene->mNumMaterials; i++) {
+        CollectMaterial(scene->mMaterials[i], package);
+    }
+
+    // 3. Jerarquia de nodos con las transformaciones ya descompuestas
+    CollectNode(scene->mRootNode, ModelFormat::NO_PARENT, package);
+
+    // 4. Escritura: tablas + un blob VMSH por malla (ver ModelFormat.h)
+    std::ofstream file(libPath, std::ios::binary | std::ios::trunc);
+    if (file.is_open()) {
+        bool ok = ModelFormat::Write(file, package);
         file.close();
-        std::cout << "[Import OK] Mesh convertida a binario: " << libPath << std::endl;
+
+        if (ok) std::cout << "[Import OK] Modelo convertido a binario (" << package.meshes.size() << " meshes, "
+            << package.nodes.size() << " nodos): " << libPath << std::endl;
+        else std::cerr << "[Error] Fallo al escribir el modelo en Library: " << libPath << std::endl;
     }
     else {
         std::cerr << "[Error] No se pudo escribir en Library: " << libPath << std::endl;
     }
 }
 
+std::string ResourceManager::GetModelPackage(const std::string& assetPath) {
+    AssetMeta meta;
+    if (!EnsureImported(assetPath, meta)) return "";
+
+    std::string libPath = "Assets/Library/" + std::to_string(meta.uid);
+    if (!IsLibraryFileCurrent(assetPath, libPath)) return "";
+    return libPath;
+}
+
+void ResourceManager::BenchmarkModelLoad(const std::string& assetPath, int iterations) {
+    std::string libPath = GetModelPackage(assetPath);
+    if (libPath.empty() || iterations <= 0) {
+        LOG("[ResMan] Benchmark: no hay paquete de Library para %s", assetPath.c_str());
+        return;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto elapsedMs = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+
+    // Both sides stop once every vertex/index is readable by glBufferData, and both
+    // read every position so the mapped pages are really faulted in (no lazy win).
+    ModelLoadBenchmark result;
+    result.assetPath = assetPath;
+    result.iterations = iterations;
+    float checksum = 0.0f;
+
+    for (int it = 0; it < iterations; it++) {
+        auto start = Clock::now();
+        {
+            Assimp::Importer importer;
+            const aiScene* scene = importer.ReadFile(assetPath, ModelImportFlags);
+            if (!scene || !scene->mRootNode) {
+                LOG("[ResMan] Benchmark: Assimp no pudo cargar %s", assetPath.c_str());
+                return;
+            }
+            ModelFormat::Package package;
+            package.meshes.resize(scene->mNumMeshes);
+            for (unsigned int i = 0; i < scene->mNumMeshes; i++) {
+                CollectMesh(scene->mMeshes[i], package.meshes[i], package);
+                for (const Vertex& vertex : package.meshes[i].vertices) checksum += vertex.Position.x;
+            }
+        }
+        double assimpMs = elapsedMs(start);
+
+        start = Clock::now();
+        {
+            MappedFile file;
+            ModelFormat::View view;
+            if (!file.Open(libPath) || !ModelFormat::Parse(file.GetData(), file.GetSize(), view)) {
+                LOG("[ResMan] Benchmark: paquete invalido %s", libPath.c_str());
+                return;
+            }
+            for (uint32_t i = 0; i < view.header->meshCount; i++) {
+                if (view.meshes[i].flags & ModelFormat::MESH_SKIPPED) continue;
+                MeshFormat::View mesh;
+                if (!MeshFormat::Parse(file.GetData() + view.meshes[i].blobOffset, (size_t)view.meshes[i].blobSize, mesh)) continue;
+                for (uint32_t v = 0; v < mesh.header->vertexCount; v++) checksum += mesh.vertices[v].Position.x;
+            }
+        }
+        double packageMs = elapsedMs(start);
+
+        // The first pass is the closest we get to a cold start (file cache may still be warm from startup)
+        if (it == 0) {
+            result.assimpColdMs = assimpMs;
+            result.packageColdMs = packageMs;
+        }
+        result.assimpAvgMs += assimpMs / iterations;
+        result.packageAvgMs += packageMs / iterations;
+    }
+
+    lastModelBenchmark = result;
+    LOG("[ResMan] Benchmark %s (%d iteraciones, checksum %.1f)", assetPath.c_str(), iterations, checksum);
+    LOG("[ResMan]   Assimp:  first %.2f ms, avg %.2f ms", result.assimpColdMs, result.assimpAvgMs);
+    LOG("[ResMan]   Library: first %.2f ms, avg %.2f ms (x%.1f)", result.packageColdMs, result.packageAvgMs,
+        result.packageAvgMs > 0.0 ? result.assimpAvgMs / result.packageAvgMs : 0.0);
+}
+
 void ResourceManager::ImportTexture(const std::string& assetPath, const std::string& libPath) {
+    // Siempre RGBA: el encoder elige BC1/BC3/BC4 segun los canales originales.
+    // En Library se guarda sin girar; los obj (que van girados) no usan Library
     int width, height, channels;
-    unsigned char* data = stbi_load(assetPath.c_str(), &width, &height, &channels, 0);
-
-    if (data) {
-        std::ofstream file(libPath, std::ios::binary);
-        if (file.is_open()) {
-            file.write((char*)&width, sizeof(int));
-            file.write((char*)&height, sizeof(int));
-            file.write((char*)&channels, sizeof(int));
-            file.write((char*)data, width * height * channels);
-            file.close();
-            std::cout << "[Import OK] Textura convertida a binario: " << libPath << std::endl;
-        }
-        stbi_image_free(data);
+    stbi_set_flip_vertically_on_load_thread(false);
+    unsigned char* data = stbi_load(assetPath.c_str(), &width, &height, &channels, 4);
+    if (!data) {
+        LOG("[ResMan] No se pudo decodificar la textura %s: %s", assetPath.c_str(), stbi_failure_reason());
+        return;
+    }
+
+    std::ofstream file(libPath, std::ios::binary);
+    if (file.is_open() && TextureFormat::Write(file, data, (uint32_t)width, (uint32_t)height, (uint32_t)channels)) {
+        std::cout << "[Import OK] Textura comprimida a Library: " << libPath << std::endl;
+    }
+    else {
+        LOG("[ResMan] Error escribiendo la textura de Library %s", libPath.c_str());
     }
+    stbi_image_free(data);
 }
 
 // ---------------------------------------------------------------------
@@ -221,54 +421,192 @@ void ResourceManager::ImportAssets() {
 
     LOG("[ResMan] Se han encontrado %d archivos en Assets.", (int)files.size());
 
-    // 4. PROCESAR
-    int importados = 0;
+    using Clock = std::chrono::steady_clock;
+    auto wallStart = Clock::now();
+
+    // 4. FASE SERIE: leer .meta / generar UIDs. Los .meta no se escriben hasta el final
+    struct ImportJob {
+        std::string path;
+        AssetMeta meta;
+        bool metaChanged = false;
+        bool imported = false;
+        double ms = 0.0;
+    };
+    std::vector<ImportJob> jobs;
+    jobs.reserve(files.size());
     for (const std::string& path : files) {
         if (path.find(".meta") != std::string::npos) continue;
 
-        VroomUUID uid = GetOrCreateMeta(path);
-        std::string libraryPath = "Assets/Library/" + std::to_string(uid);
+        ImportJob job;
+        job.path = path;
+        if (!job.meta.Load(path + ".meta")) {
+            job.meta.uid = UUIDGen::GenerateUUID();
+            job.metaChanged = true;
+        }
+        jobs.push_back(job);
+    }
 
-        // Si no existe, importamos
-        if (!fileSys->Exists(libraryPath)) {
-            LOG("[ResMan] Importando nuevo asset: %s", path.c_str());
-            SaveToLibrary(path, uid);
-            importados++;
+    // Library se crea una sola vez aqui para que los hilos no compitan creando la carpeta
+    std::filesystem::create_directories("Assets/Library");
+
+    // 5. FASE PARALELA: cada asset se comprueba (tamaño/fecha y, si hace falta, hash), se parsea
+    // (Assimp/stb_image) y se escribe en Library en su propio hilo.
+    // SaveToLibrary solo toca su propio archivo de Library, asi que no necesita locks.
+    // Grano 1 en el JobSystem: los assets se reparten de uno en uno, uno enorme no retrasa a los demas.
+    unsigned int workers = Application::GetInstance().jobs->ParallelFor(jobs.size(), [&](size_t i) {
+        ImportJob& job = jobs[i];
+        std::string libraryPath = "Assets/Library/" + std::to_string(job.meta.uid);
+
+        // Solo se importa lo que ha cambiado de verdad (contenido, importador o formato de Library)
+        if (NeedsImport(job.path, libraryPath, job.meta, job.metaChanged)) {
+            auto start = Clock::now();
+            SaveToLibrary(job.path, job.meta.uid);
+            job.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            job.imported = true;
         }
+    }, 1);
+
+    // 6. FASE SERIE: .meta de los assets nuevos y resumen
+    int importados = 0;
+    double serialMs = 0.0;
+    for (const ImportJob& job : jobs) {
+        if (job.metaChanged) job.meta.Save(job.path + ".meta");
+        if (!job.imported) continue;
+
+        importados++;
+        serialMs += job.ms;
+        LOG("[ResMan] Importado %s (%.2f ms)", job.path.c_str(), job.ms);
     }
 
+    double wallMs = std::chrono::duration<double, std::milli>(Clock::now() - wallStart).count();
+
     if (importados == 0) {
-        LOG("[ResMan] Todos los assets ya estaban importados en Library.");
+        LOG("[ResMan] Todos los assets ya estaban importados en Library (%.2f ms).", wallMs);
     }
     else {
         LOG("[ResMan] Proceso finalizado. Se importaron %d archivos.", importados);
+        // serialMs es lo que habrian tardado los mismos imports uno detras de otro
+        LOG("[ResMan] Tiempo total %.2f ms con %u hilos (suma por asset %.2f ms, speedup x%.2f)",
+            wallMs, workers, serialMs, wallMs > 0.0 ? serialMs / wallMs : 0.0);
     }
     LOG("--------------------------------------------------");
 }
 
 VroomUUID ResourceManager::GetOrCreateMeta(const std::string& path) {
-    std::string metaPath = path + ".meta";
-    auto fs = Application::GetInstance().fileSystem;
-
-    if (fs->Exists(metaPath)) {
-        std::ifstream file(metaPath);
-        std::string line;
-        if (file.is_open()) {
-            while (std::getline(file, line)) {
-                if (line.find("UID: ") != std::string::npos) {
-                    try { return std::stoull(line.substr(5)); }
-                    catch (...) { return 0; }
-                }
-            }
-        }
+    AssetMeta meta;
+    if (meta.Load(path + ".meta")) return meta.uid;
+
+    meta.uid = UUIDGen::GenerateUUID();
+    meta.time = Application::GetInstance().fileSystem->GetLastModTime(path);
+    meta.Save(path + ".meta");
+    return meta.uid;
+}
+
+void ResourceManager::GetImporterInfo(const std::string& assetPath, uint32_t& version, std::string& settings) {
+    std::string extension = assetPath.substr(assetPath.find_last_of(".") + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+    if (extension == "fbx" || extension == "obj") {
+        version = (ModelFormat::VERSION << 16) | MeshFormat::VERSION;
+        char flags[32];
+        snprintf(flags, sizeof(flags), "aiFlags=%x", ModelImportFlags);
+        settings = flags;
+    }
+    else if (extension == "png" || extension == "jpg" || extension == "tga" || extension == "jpeg") {
+        version = (TEXTURE_IMPORTER_VERSION << 16) | TextureFormat::VERSION;
+        settings = "bc=auto;mips=box";
+    }
+    else {
+        version = COPY_IMPORTER_VERSION;
+        settings = "copy";
+    }
+}
+
+bool ResourceManager::NeedsImport(const std::string& assetPath, const std::string& libraryPath, AssetMeta& meta, bool& metaChanged) {
+    auto fileSys = Application::GetInstance().fileSystem;
+
+    uint32_t version;
+    std::string settings;
+    GetImporterInfo(assetPath, version, settings);
+
+    std::error_code error;
+    uint64_t size = std::filesystem::file_size(assetPath, error);
+    long long time = fileSys->GetLastModTime(assetPath);
+
+    bool libraryOk = fileSys->Exists(libraryPath) && IsLibraryFileCurrent(assetPath, libraryPath);
+    bool importerOk = meta.importerVersion == version && meta.settings == settings;
+
+    // Camino rapido: mismo tamaño y misma fecha que en el ultimo import -> ni se lee el archivo
+    if (libraryOk && importerOk && meta.hash != 0 && meta.size == size && meta.time == time) {
+        return false;
     }
 
-    VroomUUID newUID = UUIDGen::GenerateUUID();
-    std::ofstream file(metaPath);
-    if (file.is_open()) {
-        file << "UID: " << newUID << "\n";
-        file << "Time: " << fs->GetLastModTime(path) << "\n";
-        file.close();
+    // Tocado o cambiado: decide el contenido. Un "touch" sin cambios solo actualiza la fecha del .meta
+    uint64_t hash = 0;
+    if (!ContentHash::HashFile(assetPath, hash)) {
+        LOG("[ResMan] No se pudo leer %s para calcular su hash", assetPath.c_str());
+        return !libraryOk;
+    }
+
+    bool contentChanged = hash != meta.hash;
+
+    meta.size = size;
+    meta.time = time;
+    meta.hash = hash;
+    meta.importerVersion = version;
+    meta.settings = settings;
+    metaChanged = true;
+
+    return !libraryOk || !importerOk || contentChanged;
+}
+
+bool ResourceManager::EnsureImported(const std::string& assetPath, AssetMeta& meta) {
+    std::string metaPath = assetPath + ".meta";
+
+    bool metaChanged = false;
+    if (!meta.Load(metaPath)) {
+        meta = AssetMeta();
+        meta.uid = UUIDGen::GenerateUUID();
+        metaChanged = true;
     }
-    return newUID;
+
+    std::string libPath = "Assets/Library/" + std::to_string(meta.uid);
+    if (NeedsImport(assetPath, libPath, meta, metaChanged)) {
+        std::cout << "[ResMan] Generando binario propio en Library para: " << assetPath << std::endl;
+        SaveToLibrary(assetPath, meta.uid);
+    }
+
+    if (metaChanged) meta.Save(metaPath);
+    return std::filesystem::exists(libPath);
+}
+
+bool ResourceManager::IsLibraryFileCurrent(const std::string& assetPath, const std::string& libraryPath) {
+    std::string extension = assetPath.substr(assetPath.find_last_of(".") + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+    if (extension == "fbx" || extension == "obj") {
+        return ModelFormat::IsCurrent(libraryPath);
+    }
+    if (extension == "png" || extension == "jpg" || extension == "tga" || extension == "jpeg") {
+        return TextureFormat::IsCurrent(libraryPath);
+    }
+    return true;
+}
+
+bool ResourceManager::FindLibraryFile(const std::string& assetPath, std::string& libPath) {
+    // Solo lectura: no importa ni toca el .meta, se puede llamar desde los hilos del streamer
+    AssetMeta meta;
+    if (!meta.Load(assetPath + ".meta") || meta.hash == 0) return false;
+
+    uint32_t version;
+    std::string settings;
+    GetImporterInfo(assetPath, version, settings);
+    if (meta.importerVersion != version || meta.settings != settings) return false;
+
+    std::error_code error;
+    uint64_t size = std::filesystem::file_size(assetPath, error);
+    if (error || size != meta.size || Application::GetInstance().fileSystem->GetLastModTime(assetPath) != meta.time) return false;
+
+    libPath = "Assets/Library/" + std::to_string(meta.uid);
+    return IsLibraryFileCurrent(assetPath, libPath);
 }
\ No newline at end of file
@@ -16,6 +16,7 @@
         class Lighting;
         class Shader;
         class Material;
+        struct AssetMeta;
 
         class ResourceManager {
         public:
@@ -31,6 +32,27 @@
             void ImportAssets(); 
             VroomUUID GetOrCreateMeta(const std::string& assetPath);
 
+            // Assimp post-process flags used for every model import
+            static const unsigned int ModelImportFlags;
+
+            // Library path of the model package for an fbx/obj asset, importing it first if needed.
+            // Empty when the asset can't be imported.
+            std::string GetModelPackage(const std::string& assetPath);
+
+            // Library file of an asset when it is already imported and up to date with the source.
+            // Never imports or writes the .meta, so it is safe from worker threads.
+            bool FindLibraryFile(const std::string& assetPath, std::string& libPath);
+
+            // Cold-start comparison: Assimp parse + conversion vs. mapping the Library package
+            struct ModelLoadBenchmark {
+                std::string assetPath;
+                int iterations = 0;
+                double assimpColdMs = 0.0, assimpAvgMs = 0.0;
+                double packageColdMs = 0.0, packageAvgMs = 0.0;
+            };
+            void BenchmarkModelLoad(const std::string& assetPath, int iterations = 5);
+            const ModelLoadBenchmark& GetLastModelBenchmark() const { return lastModelBenchmark; }
+
 
             bool IsResourceLoaded(const std::string& path) {
                   return m_resources.find(path) != m_resources.end();
@@ -53,14 +75,26 @@
 
 
             std::unordered_map<std::string, std::shared_ptr<Resource>> m_resources;
+            ModelLoadBenchmark lastModelBenchmark;
 
             // Opcional: Mtodo interno para cargar el recurso (esto es del gm)
             std::shared_ptr<Resource> InternalLoad(const std::string& path, const std::string& typeName);
 
             
 
+            // Importer version + settings written to the .meta; a mismatch forces a re-import
+            void GetImporterInfo(const std::string& assetPath, uint32_t& version, std::string& settings);
+            // Import decision: size+mtime fast path, content hash when they differ. Updates 'meta' with the
+            // current source state (metaChanged = true) but never writes it, so it is safe on worker threads.
+            bool NeedsImport(const std::string& assetPath, const std::string& libraryPath, AssetMeta& meta, bool& metaChanged);
+            // Serial version for single loads: reads/creates the .meta, imports if needed and saves the .meta
+            bool EnsureImported(const std::string& assetPath, AssetMeta& meta);
+
+            // Thread safe as long as no two calls share a uid (only touches its own Library file)
             void SaveToLibrary(const std::string& assetPath, VroomUUID uid);
-            void ImportMesh(const std::string& assetPath, const std::string& libraryPath);
+            // False when the Library binary was written by an older importer and must be redone
+            bool IsLibraryFileCurrent(const std::string& assetPath, const std::string& libraryPath);
+            void ImportModel(const std::string& assetPath, const std::string& libraryPath);
             void ImportTexture(const std::string& assetPath, const std::string& libraryPath);
             
         };
@@ -19,7 +19,7 @@ public:
     virtual ~Resource() = default;
 
     // Mtodos virtuales
-    virtual void Load() {} // Cada hijo (Mesh, Texture) implementar el suyo
+    virtual bool Load() { return true; } // Cada hijo (Mesh, Texture) implementar el suyo
 
     // Getters y Setters
     void SetAssetsPath(const std::string& p) { assetsPath = p; }
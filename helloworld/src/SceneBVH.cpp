@@ -0,0 +1,266 @@
+#include "SceneBVH.h"
+#include "RenderMeshComponent.h"
+#include "TransformComponent.h"
+#include "GameObject.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include "Profiler.h"
+
+using Clock = std::chrono::steady_clock;
+
+void SceneBVH::MarkDirty(RenderMeshComponent* renderer) {
+    if (renderer->bvhDirty)
+        return;
+
+    renderer->bvhDirty = true;
+    dirty.push_back(renderer);
+}
+
+void SceneBVH::Remove(RenderMeshComponent* renderer) {
+    if (renderer->bvhProxy != DynamicBVH::NullNode) {
+        tree.DestroyProxy(renderer->bvhProxy);
+        renderer->bvhProxy = DynamicBVH::NullNode;
+    }
+    if (renderer->bvhDirty) {
+        dirty.erase(std::remove(dirty.begin(), dirty.end(), renderer), dirty.end());
+        renderer->bvhDirty = false;
+    }
+}
+
+void SceneBVH::Update() {
+    PROFILE_SCOPE("SceneBVH::Update");
+    lastUpdateCount = (uint32_t)dirty.size();
+
+    for (RenderMeshComponent* renderer : dirty) {
+        renderer->bvhDirty = false;
+
+        AABB box;
+        auto owner = renderer->GetOwner();
+        if (owner && renderer->GetMesh()) {
+            auto transform = owner->GetComponent<TransformComponent>();
+            if (transform)
+                box = renderer->GetWorldAABB(*transform);
+        }
+
+        //no mesh / no transform / empty mesh: not in the tree
+        if (!IsValid(box)) {
+            if (renderer->bvhProxy != DynamicBVH::NullNode) {
+                tree.DestroyProxy(renderer->bvhProxy);
+                renderer->bvhProxy = DynamicBVH::NullNode;
+            }
+            continue;
+        }
+
+        if (renderer->bvhProxy == DynamicBVH::NullNode)
+            renderer->bvhProxy = tree.CreateProxy(box, renderer);
+        else
+            tree.MoveProxy(renderer->bvhProxy, box);
+    }
+    dirty.clear();
+}
+
+bool SceneBVH::Raycast(const glm::vec3& origin, const glm::vec3& direction, float minDistance, RaycastHit& hit) {
+    Update();
+
+    glm::vec3 invDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+    bool found = false;
+
+    tree.QueryRay(origin, direction, std::numeric_limits<float>::max(), [&](int proxy, float maxDistance) {
+        auto renderer = static_cast<RenderMeshComponent*>(tree.GetUserData(proxy));
+
+        //the leaf holds the fat box, test the real one
+        float distance;
+        if (!IntersectRayAABB(origin, invDirection, renderer->worldAABB, maxDistance, distance))
+            return maxDistance;
+        if (!precisePicking && distance <= minDistance)
+            return maxDistance;
+
+        auto owner = renderer->GetOwner();
+        auto mesh = renderer->GetMesh();
+        if (!owner || owner->IsMarkedForDestroy() || !mesh)
+            return maxDistance;
+
+        if (!precisePicking) {
+            hit.gameObject = owner;
+            hit.distance = distance;
+            hit.point = origin + direction * distance;
+            hit.normal = -direction;
+            hit.triangle = 0;
+            found = true;
+            return distance;
+        }
+
+        auto transform = owner->GetComponent<TransformComponent>();
+        if (!transform)
+            return maxDistance;
+
+        // Ray to mesh space. The direction is not renormalized so distances stay in world units
+        glm::mat4 model = transform->GetGlobalTransform();
+        glm::mat4 inverseModel = glm::inverse(model);
+        glm::vec3 localOrigin = glm::vec3(inverseModel * glm::vec4(origin, 1.0f));
+        glm::vec3 localDirection = glm::vec3(inverseModel * glm::vec4(direction, 0.0f));
+
+        TriangleBVH::Hit triangleHit;
+        if (!mesh->RaycastLocal(localOrigin, localDirection, minDistance, maxDistance, triangleHit))
+            return maxDistance;
+
+        glm::vec3 normal = glm::normalize(glm::transpose(glm::mat3(inverseModel)) * mesh->GetTriangleNormal(triangleHit.triangle));
+        if (glm::dot(normal, direction) > 0.0f)
+            normal = -normal;
+
+        hit.gameObject = owner;
+        hit.distance = triangleHit.distance;
+        hit.point = origin + direction * triangleHit.distance;
+        hit.normal = normal;
+        hit.triangle = triangleHit.triangle;
+        found = true;
+        return triangleHit.distance;
+    });
+
+    return found;
+}
+
+void SceneBVH::QueryFrustum(const Frustum& frustum, std::vector<RenderMeshComponent*>& results) {
+    Update();
+
+    tree.QueryFrustum(frustum, [&](int proxy, bool inside) {
+        auto renderer = static_cast<RenderMeshComponent*>(tree.GetUserData(proxy));
+        if (inside || frustum.Intersects(renderer->worldAABB))
+            results.push_back(renderer);
+        return true;
+    });
+}
+
+void SceneBVH::QueryBox(const AABB& box, std::vector<RenderMeshComponent*>& results) {
+    Update();
+
+    tree.QueryBox(box, [&](int proxy) {
+        auto renderer = static_cast<RenderMeshComponent*>(tree.GetUserData(proxy));
+        if (Overlaps(renderer->worldAABB, box))
+            results.push_back(renderer);
+        return true;
+    });
+}
+
+SceneBVH::BenchmarkResult SceneBVH::Benchmark(int objectCount, int rays, int frustums) {
+    BenchmarkResult result;
+    result.objectCount = objectCount;
+    result.rays = rays;
+    result.frustums = frustums;
+
+    std::mt19937 rng(1234);
+    float worldSize = 4.0f * std::cbrt((float)objectCount);   // roughly constant density
+    std::uniform_real_distribution<float> position(-worldSize * 0.5f, worldSize * 0.5f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    // Unit cube meshes with random transforms, like a scene full of props
+    AABB localBox;
+    localBox.min = glm::vec3(-0.5f);
+    localBox.max = glm::vec3(0.5f);
+
+    std::vector<glm::mat4> transforms(objectCount);
+    std::vector<AABB> worldBoxes(objectCount);
+    for (int i = 0; i < objectCount; i++) {
+        glm::mat4 m = glm::translate(glm::mat4(1.0f), glm::vec3(position(rng), position(rng), position(rng)));
+        m = glm::rotate(m, unit(rng) * 6.2831853f, glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng)) + glm::vec3(0.01f)));
+        m = glm::scale(m, glm::vec3(0.5f + unit(rng) * 1.5f));
+        transforms[i] = m;
+        worldBoxes[i] = TransformAABB(localBox, m);
+    }
+
+    auto start = Clock::now();
+    DynamicBVH bvh;
+    for (int i = 0; i < objectCount; i++)
+        bvh.CreateProxy(worldBoxes[i], (void*)(intptr_t)i);
+    result.buildMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // Rays from the edge of the world through a random point
+    std::vector<glm::vec3> origins(rays), directions(rays);
+    for (int r = 0; r < rays; r++) {
+        origins[r] = glm::vec3(position(rng), position(rng), -worldSize);
+        directions[r] = glm::normalize(glm::vec3(position(rng), position(rng), position(rng)) - origins[r]);
+    }
+
+    const float minDistance = 0.1f;
+    std::vector<int> bruteHits(rays, -1);
+
+    // Old Application::ProcessObjectSelection loop
+    start = Clock::now();
+    for (int r = 0; r < rays; r++) {
+        glm::vec3 invDirection(1.0f / directions[r].x, 1.0f / directions[r].y, 1.0f / directions[r].z);
+        float closest = std::numeric_limits<float>::max();
+        for (int i = 0; i < objectCount; i++) {
+            AABB world;
+            for (int c = 0; c < 8; c++) {
+                glm::vec3 corner((c & 1) ? localBox.max.x : localBox.min.x, (c & 2) ? localBox.max.y : localBox.min.y, (c & 4) ? localBox.max.z : localBox.min.z);
+                glm::vec3 worldCorner = glm::vec3(transforms[i] * glm::vec4(corner, 1.0f));
+                world.min = glm::min(world.min, worldCorner);
+                world.max = glm::max(world.max, worldCorner);
+            }
+
+            float distance;
+            if (IntersectRayAABB(origins[r], invDirection, world, std::numeric_limits<float>::max(), distance)
+                && distance > minDistance && distance < closest) {
+                closest = distance;
+                bruteHits[r] = i;
+            }
+        }
+    }
+    result.bruteRayMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / std::max(rays, 1);
+
+    start = Clock::now();
+    for (int r = 0; r < rays; r++) {
+        glm::vec3 invDirection(1.0f / directions[r].x, 1.0f / directions[r].y, 1.0f / directions[r].z);
+        int hit = -1;
+        bvh.QueryRay(origins[r], directions[r], std::numeric_limits<float>::max(), [&](int proxy, float maxDistance) {
+            int i = (int)(intptr_t)bvh.GetUserData(proxy);
+            float distance;
+            if (!IntersectRayAABB(origins[r], invDirection, worldBoxes[i], maxDistance, distance) || distance <= minDistance)
+                return maxDistance;
+            hit = i;
+            return distance;
+        });
+        if (hit != bruteHits[r])
+            result.mismatches++;
+    }
+    result.bvhRayMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / std::max(rays, 1);
+
+    // Cameras inside the world looking at random points
+    std::vector<Frustum> cameraFrustums(frustums);
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, worldSize * 0.5f);
+    for (int f = 0; f < frustums; f++) {
+        glm::vec3 eye(position(rng), position(rng), position(rng));
+        glm::vec3 target(position(rng), position(rng), position(rng));
+        cameraFrustums[f].Set(projection * glm::lookAt(eye, target + glm::vec3(0.001f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    }
+
+    std::vector<int> bruteVisible(frustums, 0);
+    result.visibleFraction = 0.0;
+    start = Clock::now();
+    for (int f = 0; f < frustums; f++) {
+        for (int i = 0; i < objectCount; i++) {
+            if (cameraFrustums[f].Intersects(worldBoxes[i]))
+                bruteVisible[f]++;
+        }
+    }
+    for (int f = 0; f < frustums; f++)
+        result.visibleFraction += (double)bruteVisible[f] / std::max(objectCount, 1) / std::max(frustums, 1);
+    result.bruteFrustumMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / std::max(frustums, 1);
+
+    start = Clock::now();
+    for (int f = 0; f < frustums; f++) {
+        int visible = 0;
+        bvh.QueryFrustum(cameraFrustums[f], [&](int proxy, bool inside) {
+            if (inside || cameraFrustums[f].Intersects(worldBoxes[(int)(intptr_t)bvh.GetUserData(proxy)]))
+                visible++;
+            return true;
+        });
+        if (visible != bruteVisible[f])
+            result.mismatches++;
+    }
+    result.bvhFrustumMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / std::max(frustums, 1);
+
+    return result;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include "DynamicBVH.h"
+
+class GameObject;
+class RenderMeshComponent;
+
+// Scene-wide DynamicBVH over the world AABB of every RenderMeshComponent.
+//
+// Components register themselves in SetMesh and unregister when destroyed;
+// TransformSystem::Update() flags the renderers whose world matrix changed
+// and Update() refits only those leaves. Owned by the OpenGL module.
+class SceneBVH {
+public:
+
+    // Main thread only. Queued until the next Update()
+    void MarkDirty(RenderMeshComponent* renderer);
+    void Remove(RenderMeshComponent* renderer);
+
+    // Inserts / refits / drops the leaves flagged since the last call
+    void Update();
+
+    struct RaycastHit {
+        std::shared_ptr<GameObject> gameObject;
+        float distance = 0.0f;
+        glm::vec3 point = glm::vec3(0.0f);    // world space
+        glm::vec3 normal = glm::vec3(0.0f);   // world space, facing the ray
+        uint32_t triangle = 0;                 // only with precisePicking
+    };
+
+    // Closest hit beyond minDistance. direction must be normalized. AABB broad
+    // phase through the tree, then the mesh triangle BVH when precisePicking is on
+    bool Raycast(const glm::vec3& origin, const glm::vec3& direction, float minDistance, RaycastHit& hit);
+    void QueryFrustum(const Frustum& frustum, std::vector<RenderMeshComponent*>& results);
+    void QueryBox(const AABB& box, std::vector<RenderMeshComponent*>& results);
+
+    const DynamicBVH& GetTree() const { return tree; }
+    uint32_t GetLastUpdateCount() const { return lastUpdateCount; }
+
+    // Synthetic scene of objectCount boxes: the old per-click loop (8 corners +
+    // slab test per object) against the tree, for rays and frustum queries
+    struct BenchmarkResult {
+        int objectCount = 0;
+        int rays = 0, frustums = 0;
+        double buildMs = 0.0;
+        double bruteRayMs = 0.0, bvhRayMs = 0.0;           // per query
+        double bruteFrustumMs = 0.0, bvhFrustumMs = 0.0;   // per query
+        double visibleFraction = 0.0;                       // average share of objects inside a frustum
+        int mismatches = 0;                                 // queries where both disagree, should be 0
+    };
+    static BenchmarkResult Benchmark(int objectCount, int rays = 200, int frustums = 20);
+
+    std::vector<BenchmarkResult> lastBenchmark;
+
+    // Off = stop at the world AABB like the old selection
+    bool precisePicking = true;
+
+private:
+    DynamicBVH tree;
+    std::vector<RenderMeshComponent*> dirty;
+    uint32_t lastUpdateCount = 0;
+};
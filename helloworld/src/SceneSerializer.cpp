@@ -1,4 +1,5 @@
 #include "SceneSerializer.h"
+#include "PoolAllocator.h"
 #include <fstream>
 #include <iostream>
 #include "TransformComponent.h"
@@ -33,7 +34,7 @@ json SceneSerializer::SerializeGameObject(std::shared_ptr<GameObject> go) {
     j["active"] = go->IsActive();
 
     // 1. Transform
-    auto transform = std::dynamic_pointer_cast<TransformComponent>(go->GetComponent(ComponentType::TRANSFORM));
+    auto transform = go->GetComponent<TransformComponent>();
     if (transform) {
         glm::vec3 pos = transform->GetPosition();
         glm::vec3 rot = transform->GetEulerAngles(); 
@@ -46,7 +47,7 @@ json SceneSerializer::SerializeGameObject(std::shared_ptr<GameObject> go) {
         };
     }
 
-    auto meshRenderer = std::dynamic_pointer_cast<RenderMeshComponent>(go->GetComponent(ComponentType::MESH_RENDERER));
+    auto meshRenderer = go->GetComponent<RenderMeshComponent>();
     if (meshRenderer && meshRenderer->GetMesh()) {
         
 
@@ -56,10 +57,10 @@ json SceneSerializer::SerializeGameObject(std::shared_ptr<GameObject> go) {
     }
 
     // 3. Material (Textura)
-    auto material = std::dynamic_pointer_cast<MaterialComponent>(go->GetComponent(ComponentType::MATERIAL));
+    auto material = go->GetComponent<MaterialComponent>();
     if (material && material->GetDiffuseMap()) {
         j["components"]["material"] = {
-            {"diffusePath", material->GetDiffuseMap()->path}
+            {"diffusePath", material->GetDiffuseMap().GetPath()}
         };
     }
 
@@ -100,7 +101,7 @@ void SceneSerializer::LoadScene(const std::string& filepath, std::shared_ptr<Gam
 void SceneSerializer::DeserializeGameObject(const json& j, std::shared_ptr<GameObject> parent) {
     std::string name = j.value("name", "GameObject");
 
-    auto newGO = std::make_shared<GameObject>(name);
+    auto newGO = MakePooled<GameObject>(name);
     newGO->SetParent(parent);
     parent->AddChild(newGO);
 
@@ -113,8 +114,8 @@ void SceneSerializer::DeserializeGameObject(const json& j, std::shared_ptr<GameO
         // --- 1. TRANSFORM ---
         if (components.contains("transform")) {
             auto t = components["transform"];
-            auto transComp = std::dynamic_pointer_cast<TransformComponent>(newGO->GetComponent(ComponentType::TRANSFORM));
-            if (!transComp) transComp = std::dynamic_pointer_cast<TransformComponent>(newGO->AddComponent(ComponentType::TRANSFORM));
+            auto transComp = newGO->GetComponent<TransformComponent>();
+            if (!transComp) transComp = static_cast<TransformComponent*>(newGO->AddComponent(ComponentType::TRANSFORM).get());
 
             if (transComp) {
                 glm::vec3 pos(t["position"][0], t["position"][1], t["position"][2]);
@@ -150,15 +151,8 @@ void SceneSerializer::DeserializeGameObject(const json& j, std::shared_ptr<GameO
 
             // Si AddComponent ya crea el componente y lo devuelve:
             if (materialComp) {
-                auto texture = std::make_shared<Texture>();
-
-                // Extraemos directorio y archivo para tu funcin TextureFromFile
-                std::string filename = FileSystem::GetFileName(texPath);
-                // Truco: Si texPath es "Assets/Textures/wall.jpg", dir es "Assets/Textures"
-                std::string dir = texPath.substr(0, texPath.find_last_of('/'));
-
-                // Cargar
-                texture->TextureFromFile(dir, filename.c_str());
+                // Cache por ruta: si otra escena/modelo ya la tiene cargada se reutiliza
+                TextureHandle texture = Application::GetInstance().textures->cache->Acquire(texPath, "texture_diffuse");
                 materialComp->SetDiffuseMap(texture);
             }
         }
@@ -1,74 +1,183 @@
 #include "Shader.h"
+#include <algorithm>
+
+const char* const Shader::MaterialSamplers[MATERIAL_SLOT_COUNT] = {
+    "material.texture_diffuse1",
+    "material.texture_specular1",
+    "material.texture_normal1",
+    "material.texture_roughness1",
+    "material.texture_metallic1",
+    "material.texture_ao1"
+};
 
 Shader::Shader(const char* vertexFileName, const char* fragmentFileName)
 {
     std::string vertexCode;
     std::string fragmentCode;
-    std::ifstream vShaderFile;
-    std::ifstream fShaderFile;
-
-    vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    try
+    if (!ReadSource(vertexFileName, vertexCode) || !ReadSource(fragmentFileName, fragmentCode))
     {
-        vShaderFile.open(vertexFileName);
-        fShaderFile.open(fragmentFileName);
-        std::stringstream vShaderStream, fShaderStream;
+        std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ" << std::endl;
+    }
 
-        vShaderStream << vShaderFile.rdbuf();
-        fShaderStream << fShaderFile.rdbuf();
+    Build build = StartBuild(vertexCode, fragmentCode);
+    SetProgram(FinishBuild(build));
+}
 
-        vShaderFile.close();
-        fShaderFile.close();
+bool Shader::ReadSource(const std::string& path, std::string& code)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+        return false;
 
-        vertexCode = vShaderStream.str();
-        fragmentCode = fShaderStream.str();
-    }
-    catch (std::ifstream::failure e)
-    {
-        std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ" << std::endl;
-    }
+    std::stringstream stream;
+    stream << file.rdbuf();
+    code = stream.str();
+    return true;
+}
+
+Shader::Build Shader::StartBuild(const std::string& vertexCode, const std::string& fragmentCode)
+{
     const char* vShaderCode = vertexCode.c_str();
     const char* fShaderCode = fragmentCode.c_str();
 
-    unsigned int vertex, fragment;
+    Build build;
+    build.vertex = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(build.vertex, 1, &vShaderCode, NULL);
+    glCompileShader(build.vertex);
+
+    build.fragment = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(build.fragment, 1, &fShaderCode, NULL);
+    glCompileShader(build.fragment);
+
+    // no status queries here: with parallel compile the driver is still working
+    build.program = glCreateProgram();
+    glAttachShader(build.program, build.vertex);
+    glAttachShader(build.program, build.fragment);
+    glProgramParameteri(build.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glLinkProgram(build.program);
+    return build;
+}
+
+GLuint Shader::FinishBuild(Build& build)
+{
+    if (build.program == 0)
+        return 0;
+
     int success;
     char infoLog[512];
 
-    vertex = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertex, 1, &vShaderCode, NULL);
-    glCompileShader(vertex);
-
-    glGetShaderiv(vertex, GL_COMPILE_STATUS, &success);
+    glGetProgramiv(build.program, GL_LINK_STATUS, &success);
     if (!success)
     {
-        glGetShaderInfoLog(vertex, 512, NULL, infoLog);
-        std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
-    };
+        glGetShaderiv(build.vertex, GL_COMPILE_STATUS, &success);
+        if (!success)
+        {
+            glGetShaderInfoLog(build.vertex, 512, NULL, infoLog);
+            std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
+        }
 
-    fragment = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragment, 1, &fShaderCode, NULL);
-    glCompileShader(fragment);
+        glGetShaderiv(build.fragment, GL_COMPILE_STATUS, &success);
+        if (!success)
+        {
+            glGetShaderInfoLog(build.fragment, 512, NULL, infoLog);
+            std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
+        }
 
-    glGetShaderiv(fragment, GL_COMPILE_STATUS, &success);
-    if (!success)
+        glGetProgramInfoLog(build.program, 512, NULL, infoLog);
+        std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+
+        glDeleteProgram(build.program);
+        build.program = 0;
+    }
+
+    GLuint program = build.program;
+    glDeleteShader(build.vertex);
+    glDeleteShader(build.fragment);
+    build = Build();
+    return program;
+}
+
+void Shader::ReleaseBuild(Build& build)
+{
+    if (build.program == 0)
+        return;
+    glDeleteProgram(build.program);
+    glDeleteShader(build.vertex);
+    glDeleteShader(build.fragment);
+    build = Build();
+}
+
+void Shader::SetProgram(GLuint program)
+{
+    ID = program;
+    uniformLocations.clear();
+    if (ID != 0)
+        Reflect();
+}
+
+void Shader::Reflect()
+{
+    GLint count = 0, maxLength = 0;
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::string name(std::max(maxLength, 1), '\0');
+    for (GLint i = 0; i < count; i++)
     {
-        glGetShaderInfoLog(fragment, 512, NULL, infoLog);
-        std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
-    };
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(ID, (GLuint)i, maxLength, &length, &size, &type, &name[0]);
+        std::string uniform(name.c_str(), length);
 
-    ID = glCreateProgram();
-    glAttachShader(ID, vertex);
-    glAttachShader(ID, fragment);
-    glLinkProgram(ID);
+        // uniform block members have no location
+        GLint location = glGetUniformLocation(ID, uniform.c_str());
+        if (location < 0)
+            continue;
 
-    glGetProgramiv(ID, GL_LINK_STATUS, &success);
-    if (!success)
+        // arrays are reported as "name[0]", callers use "name"
+        if (uniform.size() > 3 && uniform.compare(uniform.size() - 3, 3, "[0]") == 0)
+            uniform.resize(uniform.size() - 3);
+        uniformLocations[uniform] = location;
+    }
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(ID);
+    for (int slot = 0; slot < MATERIAL_SLOT_COUNT; slot++)
     {
-        glGetProgramInfoLog(ID, 512, NULL, infoLog);
-        std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+        GLint location = GetUniformLocation(MaterialSamplers[slot]);
+        if (location >= 0)
+            glUniform1i(location, slot);
+    }
+    glUseProgram((GLuint)previousProgram);
+
+    GLuint cameraBlock = glGetUniformBlockIndex(ID, "Camera");
+    if (cameraBlock != GL_INVALID_INDEX)
+        glUniformBlockBinding(ID, cameraBlock, CAMERA_BINDING);
+}
+
+void CameraUniforms::Upload(const glm::mat4& view, const glm::mat4& projection)
+{
+    // std140: three column major mat4, no padding
+    glm::mat4 matrices[3] = { view, projection, projection * view };
+
+    if (buffer == 0)
+    {
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(matrices), nullptr, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, Shader::CAMERA_BINDING, buffer);
     }
 
-    glDeleteShader(vertex);
-    glDeleteShader(fragment);
-}
\ No newline at end of file
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(matrices), matrices);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void CameraUniforms::Release()
+{
+    if (buffer != 0)
+        glDeleteBuffers(1, &buffer);
+    buffer = 0;
+}
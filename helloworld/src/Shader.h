@@ -8,6 +8,7 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <unordered_map>
 #include "glm/glm.hpp"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -16,32 +17,85 @@
 class Shader
 {
 public:
-    // the program ID
-    unsigned int ID;
+    // Material samplers in RenderQueue::SLOT_* order. Reflect() binds each one to the
+    // texture unit of its slot at link time, draws only bind the textures
+    static constexpr int MATERIAL_SLOT_COUNT = 6;
+    static const char* const MaterialSamplers[MATERIAL_SLOT_COUNT];
+    // "uniform Camera" block of every program, filled once per frame by CameraUniforms
+    static constexpr GLuint CAMERA_BINDING = 0;
 
+    // Program being compiled and linked, see StartBuild
+    struct Build {
+        GLuint program = 0;
+        GLuint vertex = 0;
+        GLuint fragment = 0;
+    };
+
+    // the program ID (0 = none / failed to build)
+    unsigned int ID = 0;
+
+    Shader() = default;
     // constructor reads and builds the shader
     Shader(const char* vertexPath, const char* fragmentPath);
+
+    static bool ReadSource(const std::string& path, std::string& code);
+    // Issues compile + link without waiting for the driver. The program can be read
+    // back with glGetProgramBinary once linked
+    static Build StartBuild(const std::string& vertexCode, const std::string& fragmentCode);
+    // Waits for the link if it is still running. The program, or 0 after logging the
+    // compile / link errors. The shader objects are deleted either way
+    static GLuint FinishBuild(Build& build);
+    // Drops a build that is no longer wanted
+    static void ReleaseBuild(Build& build);
+
+    // Takes program (ShaderManager swaps a reloaded one in) and reflects its uniforms
+    void SetProgram(GLuint program);
     // use/activate the shader
     void Use() {
         glUseProgram(ID);
     }
+    // Location of an active uniform from the table built at link time, -1 if the program has none
+    GLint GetUniformLocation(const std::string& name) const
+    {
+        auto it = uniformLocations.find(name);
+        return it != uniformLocations.end() ? it->second : -1;
+    }
     void setBool(const std::string& name, bool value) const
     {
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+        glUniform1i(GetUniformLocation(name), (int)value);
     }
     void setInt(const std::string& name, int value) const
     {
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+        glUniform1i(GetUniformLocation(name), value);
     }
     void setFloat(const std::string& name, float value) const
     {
-        glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+        glUniform1f(GetUniformLocation(name), value);
     }
 
     void setMat4(const std::string& name, glm::mat4 value) const 
     {
-        glUniformMatrix4fv(glad_glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
+        glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value));
     }
+
+private:
+    // Active uniforms -> locations, sampler units and the camera block binding
+    void Reflect();
+
+    std::unordered_map<std::string, GLint> uniformLocations;
+};
+
+// The std140 "uniform Camera" block (view, projection, viewProjection) shared by
+// every program at Shader::CAMERA_BINDING. Upload once per frame instead of
+// setting the matrices on each program
+class CameraUniforms
+{
+public:
+    void Upload(const glm::mat4& view, const glm::mat4& projection);
+    void Release();
+
+private:
+    GLuint buffer = 0;
 };
 
 #endif
@@ -0,0 +1,346 @@
+#include "ShaderManager.h"
+#include "ContentHash.h"
+#include "Application.h"
+#include "Render.h"
+#include "Log.h"
+#include "Profiler.h"
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <cstring>
+
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    const char* const LIBRARY_DIR = "Assets/Library/Shaders";
+
+    constexpr uint32_t BINARY_MAGIC = 0x48535356; // "VSSH"
+    constexpr uint32_t BINARY_VERSION = 1;
+
+    // Updates a retired program survives: the pipelined snapshot drawn next frame
+    // was extracted with it
+    constexpr int RETIRE_FRAMES = 3;
+
+    struct BinaryHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t format;          // glGetProgramBinary format, driver specific
+        uint32_t size;
+        uint64_t hash;
+    };
+
+    long long GetFileTime(const std::string& path) {
+        std::error_code error;
+        auto time = std::filesystem::last_write_time(path, error);
+        return error ? 0 : (long long)time.time_since_epoch().count();
+    }
+
+    std::string GetBinaryPath(uint64_t hash) {
+        return std::string(LIBRARY_DIR) + "/" + ContentHash::ToHex(hash) + ".bin";
+    }
+}
+
+ShaderManager& ShaderManager::GetInstance() {
+    static ShaderManager* instance = new ShaderManager(); // never destroyed on purpose
+    return *instance;
+}
+
+void ShaderManager::DetectDriver() {
+    auto text = [](GLenum name) {
+        const GLubyte* value = glGetString(name);
+        return value ? std::string((const char*)value) : std::string();
+    };
+    // a new driver or GPU can't load the old binaries anyway, give them other hashes
+    driverKey = text(GL_VENDOR) + "|" + text(GL_RENDERER) + "|" + text(GL_VERSION);
+
+    GLint extensionCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+    for (GLint i = 0; i < extensionCount; i++) {
+        const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+        if (extension && (std::strcmp(extension, "GL_KHR_parallel_shader_compile") == 0
+            || std::strcmp(extension, "GL_ARB_parallel_shader_compile") == 0)) {
+            stats.parallelCompile = true;
+            break;
+        }
+    }
+
+    LOG("ShaderManager: %s, parallel compile %s", driverKey.c_str(), stats.parallelCompile ? "on" : "off");
+}
+
+uint64_t ShaderManager::HashSources(const std::string& vertexCode, const std::string& fragmentCode) const {
+    uint64_t hash = ContentHash::XXH64(vertexCode.data(), vertexCode.size());
+    hash = ContentHash::XXH64(fragmentCode.data(), fragmentCode.size(), hash);
+    return ContentHash::XXH64(driverKey.data(), driverKey.size(), hash);
+}
+
+GLuint ShaderManager::LinkFromLibrary(uint64_t hash) {
+    std::ifstream file(GetBinaryPath(hash), std::ios::binary);
+    if (!file.is_open())
+        return 0;
+
+    BinaryHeader header;
+    if (!file.read((char*)&header, sizeof(header)) || header.magic != BINARY_MAGIC
+        || header.version != BINARY_VERSION || header.hash != hash || header.size == 0)
+        return 0;
+
+    std::vector<char> binary(header.size);
+    if (!file.read(binary.data(), binary.size()))
+        return 0;
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, (GLenum)header.format, binary.data(), (GLsizei)binary.size());
+
+    // the driver may refuse binaries from another version: just compile again
+    GLint linked = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+void ShaderManager::SaveToLibrary(uint64_t hash, GLuint program) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0)
+        return;
+
+    std::error_code error;
+    std::filesystem::create_directories(LIBRARY_DIR, error);
+
+    std::string path = GetBinaryPath(hash);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG("ShaderManager: could not write %s", path.c_str());
+        return;
+    }
+
+    BinaryHeader header = { BINARY_MAGIC, BINARY_VERSION, (uint32_t)format, (uint32_t)written, hash };
+    file.write((const char*)&header, sizeof(header));
+    file.write(binary.data(), written);
+}
+
+Shader* ShaderManager::Load(const std::string& vertexPath, const std::string& fragmentPath) {
+    for (const auto& entry : entries) {
+        if (entry->vertexPath == vertexPath && entry->fragmentPath == fragmentPath)
+            return entry->shader.get();
+    }
+
+    auto start = Clock::now();
+    if (driverKey.empty())
+        DetectDriver();
+
+    auto entry = std::make_unique<Entry>();
+    entry->vertexPath = vertexPath;
+    entry->fragmentPath = fragmentPath;
+    entry->vertexTime = GetFileTime(vertexPath);
+    entry->fragmentTime = GetFileTime(fragmentPath);
+    entry->shader = std::make_unique<Shader>();
+
+    std::string vertexCode;
+    std::string fragmentCode;
+    if (!Shader::ReadSource(vertexPath, vertexCode) || !Shader::ReadSource(fragmentPath, fragmentCode))
+        LOG("ShaderManager: could not read %s / %s", vertexPath.c_str(), fragmentPath.c_str());
+    entry->hash = HashSources(vertexCode, fragmentCode);
+
+    GLuint program = LinkFromLibrary(entry->hash);
+    bool fromLibrary = program != 0;
+    if (fromLibrary) {
+        stats.binaryHits++;
+    }
+    else {
+        Shader::Build build = Shader::StartBuild(vertexCode, fragmentCode);
+        program = Shader::FinishBuild(build);
+        if (program != 0) {
+            stats.compiled++;
+            SaveToLibrary(entry->hash, program);
+        }
+        else {
+            stats.failed++;
+        }
+    }
+    entry->shader->SetProgram(program);
+
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    stats.startupMs += ms;
+    stats.programs = (uint32_t)entries.size() + 1;
+    LOG("ShaderManager: %s + %s %s in %.2f ms", vertexPath.c_str(), fragmentPath.c_str(),
+        program == 0 ? "FAILED" : fromLibrary ? "from Library binary" : "compiled", ms);
+
+    entries.push_back(std::move(entry));
+    return entries.back()->shader.get();
+}
+
+void ShaderManager::Update(float dt) {
+    PROFILE_SCOPE("ShaderManager::Update");
+
+    // deleted once no snapshot still in flight can draw with them
+    for (size_t i = 0; i < retired.size();) {
+        if (--retired[i].frames > 0) {
+            ++i;
+            continue;
+        }
+        Application::GetInstance().render->renderQueue.ForgetProgram(retired[i].program);
+        glDeleteProgram(retired[i].program);
+        retired[i] = retired.back();
+        retired.pop_back();
+    }
+
+    FinishReloads();
+
+    if (scanning) {
+        if (!scanCounter.IsDone())
+            return;
+        scanning = false;
+        StartReloads();
+    }
+
+    sinceLastScan += dt;
+    if (forceScan || (hotReload && sinceLastScan >= pollInterval))
+        StartScan();
+}
+
+void ShaderManager::StartScan() {
+    struct Target {
+        size_t entry;
+        std::string vertexPath;
+        std::string fragmentPath;
+        long long vertexTime;
+        long long fragmentTime;
+    };
+
+    // the job only sees these copies, the entries stay main thread only
+    std::vector<Target> targets;
+    for (size_t i = 0; i < entries.size(); i++) {
+        const Entry& entry = *entries[i];
+        targets.push_back({ i, entry.vertexPath, entry.fragmentPath, entry.vertexTime, entry.fragmentTime });
+    }
+
+    bool force = forceScan;
+    forceScan = false;
+    sinceLastScan = 0.0f;
+    scanResults.clear();
+    scanning = true;
+
+    Application::GetInstance().jobs->Run([this, targets, force]() {
+        PROFILE_SCOPE("ShaderManager::Scan");
+        for (const Target& target : targets) {
+            ScanResult result;
+            result.entry = target.entry;
+            result.vertexTime = GetFileTime(target.vertexPath);
+            result.fragmentTime = GetFileTime(target.fragmentPath);
+            if (!force && result.vertexTime == target.vertexTime && result.fragmentTime == target.fragmentTime)
+                continue;
+
+            // an editor may still be writing it: try again on the next scan
+            if (!Shader::ReadSource(target.vertexPath, result.vertexCode) || !Shader::ReadSource(target.fragmentPath, result.fragmentCode))
+                continue;
+
+            result.hash = HashSources(result.vertexCode, result.fragmentCode);
+            scanResults.push_back(std::move(result));
+        }
+    }, &scanCounter);
+}
+
+void ShaderManager::StartReloads() {
+    for (ScanResult& result : scanResults) {
+        Entry& entry = *entries[result.entry];
+        entry.vertexTime = result.vertexTime;
+        entry.fragmentTime = result.fragmentTime;
+
+        // touched but not changed, or the version already compiling
+        bool compiling = entry.pending.program != 0;
+        if ((!compiling && result.hash == entry.hash) || (compiling && result.hash == entry.pendingHash))
+            continue;
+        if (compiling)
+            Shader::ReleaseBuild(entry.pending);
+        if (result.hash == entry.hash)
+            continue;
+
+        // back to a version compiled before: straight from the Library
+        GLuint program = LinkFromLibrary(result.hash);
+        if (program != 0) {
+            stats.binaryHits++;
+            Swap(entry, program, result.hash);
+            continue;
+        }
+
+        LOG("ShaderManager: %s / %s changed, recompiling", entry.vertexPath.c_str(), entry.fragmentPath.c_str());
+        entry.pending = Shader::StartBuild(result.vertexCode, result.fragmentCode);
+        entry.pendingHash = result.hash;
+    }
+    scanResults.clear();
+}
+
+bool ShaderManager::IsBuildDone(const Shader::Build& build) const {
+    if (!stats.parallelCompile)
+        return true;
+
+    GLint done = GL_FALSE;
+    glGetProgramiv(build.program, GL_COMPLETION_STATUS_KHR, &done);
+    return done == GL_TRUE;
+}
+
+void ShaderManager::FinishReloads() {
+    for (auto& entry : entries) {
+        if (entry->pending.program == 0 || !IsBuildDone(entry->pending))
+            continue;
+
+        GLuint program = Shader::FinishBuild(entry->pending);
+        if (program == 0) {
+            stats.failed++;
+            LOG("ShaderManager: %s / %s failed to compile, keeping the previous program", entry->vertexPath.c_str(), entry->fragmentPath.c_str());
+            continue;
+        }
+
+        stats.compiled++;
+        SaveToLibrary(entry->pendingHash, program);
+        Swap(*entry, program, entry->pendingHash);
+    }
+}
+
+void ShaderManager::Swap(Entry& entry, GLuint program, uint64_t hash) {
+    Retire(entry.shader->ID);
+    entry.shader->SetProgram(program);
+    entry.hash = hash;
+    stats.reloads++;
+    LOG("ShaderManager: reloaded %s / %s", entry.vertexPath.c_str(), entry.fragmentPath.c_str());
+}
+
+void ShaderManager::Retire(GLuint program) {
+    if (program != 0)
+        retired.push_back({ program, RETIRE_FRAMES });
+}
+
+void ShaderManager::CleanUp() {
+    if (scanning) {
+        Application::GetInstance().jobs->Wait(scanCounter);
+        scanning = false;
+    }
+    scanResults.clear();
+
+    for (auto& entry : entries) {
+        Shader::ReleaseBuild(entry->pending);
+        if (entry->shader->ID != 0)
+            glDeleteProgram(entry->shader->ID);
+        entry->shader->SetProgram(0);
+    }
+    entries.clear();
+
+    for (const Retired& program : retired)
+        glDeleteProgram(program.program);
+    retired.clear();
+    stats.programs = 0;
+}
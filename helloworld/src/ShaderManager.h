@@ -0,0 +1,110 @@
+#pragma once
+#include "Shader.h"
+#include "JobSystem.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+
+// Owns every shader program of the engine.
+//
+// Programs are keyed by the XXH64 of their sources (plus the GL vendor,
+// renderer and version strings). The linked binary is stored as
+// Assets/Library/Shaders/<hash>.bin with glGetProgramBinary, so the next
+// start links straight from it and only compiles when the sources or the
+// driver changed.
+//
+// With hotReload on, Update() has a job check the files of every loaded
+// program every pollInterval seconds and read the changed sources off the
+// main thread. The new program is compiled in the background when the driver
+// has KHR/ARB_parallel_shader_compile (its completion is polled, never waited
+// on). Until it links, the Shader keeps drawing with the old program; then
+// Update() swaps it in at the start of the frame. The old program is deleted a
+// few frames later, once no render snapshot can still use it. If a program
+// fails to compile, the errors are logged and the old program is kept.
+class ShaderManager {
+public:
+
+    struct Stats {
+        uint32_t programs = 0;
+        uint32_t binaryHits = 0;      // linked from the Library
+        uint32_t compiled = 0;        // from source, start-up and reloads
+        uint32_t reloads = 0;         // programs swapped at runtime
+        uint32_t failed = 0;
+        double startupMs = 0.0;       // every Load() call added up
+        bool parallelCompile = false;
+    };
+
+    // Lives until the process exits, like the other engine wide singletons
+    static ShaderManager& GetInstance();
+
+    // Same Shader for the same pair of files; the manager keeps ownership.
+    // Blocks until the program is linked (start-up)
+    Shader* Load(const std::string& vertexPath, const std::string& fragmentPath);
+
+    // Main thread, once per frame before the frame is extracted (OpenGL::Update)
+    void Update(float dt);
+    // Checks every file on the next Update, whatever their modification time
+    void ReloadAll() { forceScan = true; }
+    // Deletes every program, while the GL context is still alive
+    void CleanUp();
+
+    const Stats& GetStats() const { return stats; }
+
+    bool hotReload = true;
+    float pollInterval = 0.5f;        // seconds between two file checks
+
+private:
+    ShaderManager() = default;
+
+    struct Entry {
+        std::string vertexPath;
+        std::string fragmentPath;
+        std::unique_ptr<Shader> shader;
+        uint64_t hash = 0;
+        long long vertexTime = 0;
+        long long fragmentTime = 0;
+        // background compile of a changed version
+        Shader::Build pending;
+        uint64_t pendingHash = 0;
+    };
+
+    // What the scan job found for one entry
+    struct ScanResult {
+        size_t entry = 0;
+        uint64_t hash = 0;
+        long long vertexTime = 0;
+        long long fragmentTime = 0;
+        std::string vertexCode;
+        std::string fragmentCode;
+    };
+
+    struct Retired {
+        GLuint program = 0;
+        int frames = 0;               // Update() calls left before it is deleted
+    };
+
+    uint64_t HashSources(const std::string& vertexCode, const std::string& fragmentCode) const;
+    GLuint LinkFromLibrary(uint64_t hash);
+    void SaveToLibrary(uint64_t hash, GLuint program);
+
+    void StartScan();
+    void StartReloads();
+    void FinishReloads();
+    void Swap(Entry& entry, GLuint program, uint64_t hash);
+    void Retire(GLuint program);
+    bool IsBuildDone(const Shader::Build& build) const;
+    void DetectDriver();
+
+    std::vector<std::unique_ptr<Entry>> entries;
+    std::vector<Retired> retired;
+
+    JobSystem::Counter scanCounter;
+    bool scanning = false;
+    bool forceScan = false;
+    std::vector<ScanResult> scanResults;   // written by the scan job, read once scanCounter is done
+    float sinceLastScan = 0.0f;
+
+    std::string driverKey;                 // empty until the first Load (needs the GL context)
+    Stats stats;
+};
@@ -1,18 +1,36 @@
 #pragma once
-#include <windows.h>
-#include <psapi.h>
 #include <thread>
 #include <string>
 
-float GetMemoryUsageMB() {
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <cstdio>
+#include <unistd.h>
+#endif
+
+// Private memory of the process (Windows), resident set elsewhere
+inline float GetMemoryUsageMB() {
+#ifdef _WIN32
     PROCESS_MEMORY_COUNTERS_EX pmc;
     if (GetProcessMemoryInfo(GetCurrentProcess(), (PROCESS_MEMORY_COUNTERS*)&pmc, sizeof(pmc))) {
         return pmc.PrivateUsage / 1024.0f / 1024.0f;
     }
+#elif defined(__linux__)
+    long pages = 0, resident = 0;
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (statm) {
+        int read = std::fscanf(statm, "%ld %ld", &pages, &resident);
+        std::fclose(statm);
+        if (read == 2)
+            return resident * (float)sysconf(_SC_PAGESIZE) / 1024.0f / 1024.0f;
+    }
+#endif
     return 0.0f;
 }
 
-static unsigned int GetCPUCoreCount()
+inline unsigned int GetCPUCoreCount()
 {
     return std::thread::hardware_concurrency();
-}
\ No newline at end of file
+}
@@ -0,0 +1,108 @@
+#include "TextureCache.h"
+#include "TextureStreamer.h"
+#include "Textures.h"
+#include "Application.h"
+#include "Log.h"
+#include <filesystem>
+#include <algorithm>
+
+const std::string& TextureHandle::GetPath() const {
+    static const std::string empty;
+    return entry ? entry->path : empty;
+}
+
+bool TextureHandle::GetSize(int& width, int& height) const {
+    if (!entry) return false;
+
+    if (entry->width > 0) {
+        width = entry->width;
+        height = entry->height;
+        return true;
+    }
+
+    auto streamer = Application::GetInstance().textures->streamer;
+    return streamer && streamer->GetSize(entry->id, width, height);
+}
+
+std::string TextureCache::NormalizeKey(const std::string& path) {
+    std::string key = std::filesystem::path(path).lexically_normal().generic_string();
+#ifdef _WIN32
+    // Rutas de Windows: "Textures/A.png" y "textures/a.png" son el mismo archivo
+    std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+#endif
+    return key;
+}
+
+TextureHandle TextureCache::Acquire(const std::string& path, const std::string& mapType, bool async, bool flipVertically) {
+    std::string key = NormalizeKey(path);
+
+    auto it = entries.find(key);
+    if (it != entries.end()) return TextureHandle(it->second, mapType);
+
+    // Texture sigue siendo el loader; solo se usa para crear la textura de GL
+    std::string directory, fileName = path;
+    size_t lastSlash = path.find_last_of("/\\");
+    if (lastSlash != std::string::npos) {
+        directory = path.substr(0, lastSlash);
+        fileName = path.substr(lastSlash + 1);
+    }
+
+    Texture loader;
+    if (async) loader.TextureFromFileAsync(directory, fileName.c_str(), flipVertically);
+    else loader.TextureFromFile(directory, fileName.c_str(), flipVertically);
+
+    auto entry = std::make_shared<TextureEntry>();
+    entry->id = loader.id;
+    entry->path = path;
+    entry->width = loader.texW;
+    entry->height = loader.texH;
+
+    entries.emplace(key, entry);
+    return TextureHandle(entry, mapType);
+}
+
+TextureHandle TextureCache::Adopt(const std::string& key, GLuint id, const std::string& mapType) {
+    auto entry = std::make_shared<TextureEntry>();
+    entry->id = id;
+    entry->path = key;
+
+    // Si ya habia algo con esa clave se sustituye; la textura vieja vive mientras queden handles
+    entries[key] = entry;
+    return TextureHandle(entry, mapType);
+}
+
+TextureHandle TextureCache::Find(const std::string& key, const std::string& mapType) const {
+    auto it = entries.find(key);
+    if (it == entries.end()) return TextureHandle();
+    return TextureHandle(it->second, mapType);
+}
+
+size_t TextureCache::EvictUnused() {
+    auto streamer = Application::GetInstance().textures->streamer;
+
+    size_t evicted = 0;
+    for (auto it = entries.begin(); it != entries.end();) {
+        // Solo la cache la referencia: ninguna malla ni material la usa ya
+        if (it->second.use_count() == 1) {
+            GLuint id = it->second->id;
+            glDeleteTextures(1, &id);
+            if (streamer) streamer->Forget(id);
+            it = entries.erase(it);
+            evicted++;
+        }
+        else {
+            ++it;
+        }
+    }
+
+    if (evicted > 0) LOG("[Textures] Evicted %d unused textures (%d still cached)", (int)evicted, (int)entries.size());
+    return evicted;
+}
+
+size_t TextureCache::GetUnusedCount() const {
+    size_t unused = 0;
+    for (const auto& [key, entry] : entries) {
+        if (entry.use_count() == 1) unused++;
+    }
+    return unused;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include "glad/glad.h"
+
+// One GPU texture shared by every mesh/material that uses the same file
+struct TextureEntry {
+    GLuint id = 0;
+    std::string path;
+    int width = 0, height = 0;  // filled for synchronous loads, streamed ones ask the TextureStreamer
+};
+
+// What meshes and materials keep instead of a Texture copy: a reference to the
+// shared entry plus the slot it is bound to ("texture_diffuse"...). Copying a
+// handle only bumps the reference count the cache uses to find unused textures.
+class TextureHandle {
+public:
+    TextureHandle() = default;
+    TextureHandle(std::shared_ptr<TextureEntry> entry, const std::string& mapType) : entry(entry), mapType(mapType) {}
+
+    explicit operator bool() const { return entry != nullptr; }
+
+    GLuint GetId() const { return entry ? entry->id : 0; }
+    const std::string& GetPath() const;
+    // Real size once resident; false while a streamed texture still shows the placeholder
+    bool GetSize(int& width, int& height) const;
+
+    std::string mapType;
+
+private:
+    std::shared_ptr<TextureEntry> entry;
+};
+
+// Every loaded texture by normalized path, O(1) lookup. Owned by the Texture module
+class TextureCache {
+public:
+
+    // Loads on first use (async = streamed with the checkers placeholder) and
+    // returns the cached texture afterwards. flipVertically only applies to that first load
+    TextureHandle Acquire(const std::string& path, const std::string& mapType, bool async = true, bool flipVertically = false);
+
+    // Takes ownership of a texture created elsewhere (solid colors...) under a custom key
+    TextureHandle Adopt(const std::string& key, GLuint id, const std::string& mapType);
+    TextureHandle Find(const std::string& key, const std::string& mapType) const;
+
+    // Deletes the GPU textures nobody holds a handle to. Returns how many were freed
+    size_t EvictUnused();
+
+    size_t GetCount() const { return entries.size(); }
+    size_t GetUnusedCount() const;
+
+    // "../Assets\\Textures/./a.png" and "../Assets/Textures/a.png" are the same key
+    static std::string NormalizeKey(const std::string& path);
+
+private:
+    std::unordered_map<std::string, std::shared_ptr<TextureEntry>> entries;
+};
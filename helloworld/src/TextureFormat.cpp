@@ -0,0 +1,326 @@
+#include "TextureFormat.h"
+#include "MeshFormat.h"
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <cstdint>
+
+static_assert(sizeof(TextureFormat::Header) % 8 == 0, "Header must keep 64-bit offsets aligned");
+static_assert(sizeof(TextureFormat::Mip) % 8 == 0, "Mip table entries must keep 64-bit offsets aligned");
+
+namespace TextureFormat {
+
+    using MeshFormat::Align;
+
+    uint32_t GetBlockSize(uint32_t encoding) {
+        return encoding == ENCODING_BC3 ? 16 : 8;
+    }
+
+    uint64_t ComputeMipSize(uint32_t encoding, uint32_t width, uint32_t height) {
+        uint64_t blocksX = (width + 3) / 4;
+        uint64_t blocksY = (height + 3) / 4;
+        return blocksX * blocksY * GetBlockSize(encoding);
+    }
+
+    // --- Block encoders -------------------------------------------------
+    // Small, dependency free BC1/BC3/BC4 encoders: principal axis endpoints for
+    // color, min/max for alpha, nearest palette entry per texel. Not as good as
+    // an iterative encoder but it runs once per asset at import time.
+
+    static uint16_t To565(const float color[3]) {
+        int r = std::clamp((int)(color[0] * 31.0f / 255.0f + 0.5f), 0, 31);
+        int g = std::clamp((int)(color[1] * 63.0f / 255.0f + 0.5f), 0, 63);
+        int b = std::clamp((int)(color[2] * 31.0f / 255.0f + 0.5f), 0, 31);
+        return (uint16_t)((r << 11) | (g << 5) | b);
+    }
+
+    static void From565(uint16_t value, int color[3]) {
+        int r = (value >> 11) & 31, g = (value >> 5) & 63, b = value & 31;
+        color[0] = (r << 3) | (r >> 2);
+        color[1] = (g << 2) | (g >> 4);
+        color[2] = (b << 3) | (b >> 2);
+    }
+
+    // texels: 16 RGBA pixels, row by row
+    static void EncodeColorBlock(const uint8_t* texels, uint8_t* out) {
+        float mean[3] = { 0, 0, 0 };
+        for (int i = 0; i < 16; ++i) {
+            for (int c = 0; c < 3; ++c) mean[c] += texels[i * 4 + c];
+        }
+        for (int c = 0; c < 3; ++c) mean[c] /= 16.0f;
+
+        float cov[6] = { 0, 0, 0, 0, 0, 0 }; // rr rg rb gg gb bb
+        for (int i = 0; i < 16; ++i) {
+            float r = texels[i * 4 + 0] - mean[0];
+            float g = texels[i * 4 + 1] - mean[1];
+            float b = texels[i * 4 + 2] - mean[2];
+            cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+            cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+        }
+
+        // Eje principal por iteracion de potencias
+        float axis[3] = { 1.0f, 1.0f, 1.0f };
+        for (int iteration = 0; iteration < 8; ++iteration) {
+            float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+            float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+            float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+            float length = std::max({ std::abs(x), std::abs(y), std::abs(z) });
+            if (length < 1e-6f) break;
+            axis[0] = x / length; axis[1] = y / length; axis[2] = z / length;
+        }
+
+        float minT = 0.0f, maxT = 0.0f;
+        for (int i = 0; i < 16; ++i) {
+            float t = (texels[i * 4 + 0] - mean[0]) * axis[0] + (texels[i * 4 + 1] - mean[1]) * axis[1] + (texels[i * 4 + 2] - mean[2]) * axis[2];
+            minT = std::min(minT, t);
+            maxT = std::max(maxT, t);
+        }
+
+        // Recortamos 1/16 del rango en cada extremo: los puntos intermedios quedan mejor repartidos
+        float inset = (maxT - minT) / 16.0f;
+        minT += inset;
+        maxT -= inset;
+
+        float high[3], low[3];
+        for (int c = 0; c < 3; ++c) {
+            high[c] = mean[c] + axis[c] * maxT;
+            low[c] = mean[c] + axis[c] * minT;
+        }
+
+        uint16_t color0 = To565(high);
+        uint16_t color1 = To565(low);
+        if (color0 < color1) std::swap(color0, color1);
+
+        uint32_t indices = 0;
+        if (color0 != color1) {
+            int palette[4][3];
+            From565(color0, palette[0]);
+            From565(color1, palette[1]);
+            for (int c = 0; c < 3; ++c) {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+            }
+
+            for (int i = 0; i < 16; ++i) {
+                int best = 0, bestDistance = INT32_MAX;
+                for (int p = 0; p < 4; ++p) {
+                    int dr = texels[i * 4 + 0] - palette[p][0];
+                    int dg = texels[i * 4 + 1] - palette[p][1];
+                    int db = texels[i * 4 + 2] - palette[p][2];
+                    int distance = dr * dr + dg * dg + db * db;
+                    if (distance < bestDistance) { bestDistance = distance; best = p; }
+                }
+                indices |= (uint32_t)best << (i * 2);
+            }
+        }
+
+        out[0] = (uint8_t)(color0 & 0xFF);
+        out[1] = (uint8_t)(color0 >> 8);
+        out[2] = (uint8_t)(color1 & 0xFF);
+        out[3] = (uint8_t)(color1 >> 8);
+        memcpy(out + 4, &indices, 4);
+    }
+
+    // values: 16 single channel samples (alpha for BC3, red for BC4)
+    static void EncodeSingleChannelBlock(const uint8_t* values, uint8_t* out) {
+        uint8_t maxValue = *std::max_element(values, values + 16);
+        uint8_t minValue = *std::min_element(values, values + 16);
+
+        out[0] = maxValue;
+        out[1] = minValue;
+
+        uint64_t indices = 0;
+        if (maxValue != minValue) {
+            // a0 > a1: modo de 8 valores, 6 interpolados
+            int palette[8];
+            palette[0] = maxValue;
+            palette[1] = minValue;
+            for (int p = 1; p <= 6; ++p) {
+                palette[p + 1] = ((7 - p) * maxValue + p * minValue) / 7;
+            }
+
+            for (int i = 0; i < 16; ++i) {
+                int best = 0, bestDistance = INT32_MAX;
+                for (int p = 0; p < 8; ++p) {
+                    int distance = std::abs((int)values[i] - palette[p]);
+                    if (distance < bestDistance) { bestDistance = distance; best = p; }
+                }
+                indices |= (uint64_t)best << (i * 3);
+            }
+        }
+
+        for (int b = 0; b < 6; ++b) out[2 + b] = (uint8_t)(indices >> (b * 8));
+    }
+
+    static void CompressLevel(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t encoding, uint8_t* out) {
+        uint8_t texels[64];
+        uint8_t channel[16];
+
+        for (uint32_t by = 0; by < height; by += 4) {
+            for (uint32_t bx = 0; bx < width; bx += 4) {
+                // Los bloques del borde repiten el ultimo pixel (mips de 1x1, 2x2...)
+                for (uint32_t y = 0; y < 4; ++y) {
+                    for (uint32_t x = 0; x < 4; ++x) {
+                        uint32_t sx = std::min(bx + x, width - 1);
+                        uint32_t sy = std::min(by + y, height - 1);
+                        memcpy(&texels[(y * 4 + x) * 4], &rgba[((size_t)sy * width + sx) * 4], 4);
+                    }
+                }
+
+                if (encoding == ENCODING_BC4) {
+                    for (int i = 0; i < 16; ++i) channel[i] = texels[i * 4];
+                    EncodeSingleChannelBlock(channel, out);
+                    out += 8;
+                }
+                else if (encoding == ENCODING_BC3) {
+                    for (int i = 0; i < 16; ++i) channel[i] = texels[i * 4 + 3];
+                    EncodeSingleChannelBlock(channel, out);
+                    EncodeColorBlock(texels, out + 8);
+                    out += 16;
+                }
+                else {
+                    EncodeColorBlock(texels, out);
+                    out += 8;
+                }
+            }
+        }
+    }
+
+    // 2x2 box filter; odd sizes reuse the last row/column
+    static void Downsample(const std::vector<uint8_t>& source, uint32_t width, uint32_t height, std::vector<uint8_t>& target) {
+        uint32_t targetW = std::max(1u, width / 2);
+        uint32_t targetH = std::max(1u, height / 2);
+        target.resize((size_t)targetW * targetH * 4);
+
+        for (uint32_t y = 0; y < targetH; ++y) {
+            uint32_t y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+            for (uint32_t x = 0; x < targetW; ++x) {
+                uint32_t x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+                for (int c = 0; c < 4; ++c) {
+                    int sum = source[((size_t)y0 * width + x0) * 4 + c] + source[((size_t)y0 * width + x1) * 4 + c]
+                        + source[((size_t)y1 * width + x0) * 4 + c] + source[((size_t)y1 * width + x1) * 4 + c];
+                    target[((size_t)y * targetW + x) * 4 + c] = (uint8_t)((sum + 2) / 4);
+                }
+            }
+        }
+    }
+
+    // --- File layout ----------------------------------------------------
+
+    bool Write(std::ostream& out, const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t sourceChannels) {
+        if (rgba == nullptr || width == 0 || height == 0) return false;
+
+        uint32_t encoding = ENCODING_BC1;
+        if (sourceChannels == 1) {
+            encoding = ENCODING_BC4;
+        }
+        else if (sourceChannels == 2 || sourceChannels == 4) {
+            // Un PNG RGBA totalmente opaco no necesita BC3 (la mitad de tamaño con BC1)
+            size_t pixelCount = (size_t)width * height;
+            for (size_t i = 0; i < pixelCount; ++i) {
+                if (rgba[i * 4 + 3] != 255) { encoding = ENCODING_BC3; break; }
+            }
+        }
+
+        Header header = {};
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.encoding = encoding;
+        header.width = width;
+        header.height = height;
+        header.sourceChannels = sourceChannels;
+        header.mipsOffset = Align(sizeof(Header));
+
+        uint32_t mipCount = 1;
+        while (mipCount < MAX_MIPS && ((width >> mipCount) > 0 || (height >> mipCount) > 0)) mipCount++;
+        header.mipCount = mipCount;
+
+        Mip mips[MAX_MIPS] = {};
+        uint64_t cursor = Align(header.mipsOffset + (uint64_t)mipCount * sizeof(Mip));
+        for (uint32_t level = 0; level < mipCount; ++level) {
+            mips[level].width = std::max(1u, width >> level);
+            mips[level].height = std::max(1u, height >> level);
+            mips[level].size = (uint32_t)ComputeMipSize(encoding, mips[level].width, mips[level].height);
+            mips[level].offset = cursor;
+            cursor = Align(cursor + mips[level].size);
+        }
+        header.totalSize = cursor;
+
+        uint64_t written = 0;
+        std::vector<uint8_t> padding(MeshFormat::SECTION_ALIGNMENT, 0);
+        auto padTo = [&](uint64_t target) {
+            while (written < target) {
+                uint64_t chunk = std::min<uint64_t>(target - written, padding.size());
+                out.write((const char*)padding.data(), (std::streamsize)chunk);
+                written += chunk;
+            }
+        };
+
+        out.write((const char*)&header, sizeof(Header));
+        written += sizeof(Header);
+        padTo(header.mipsOffset);
+        out.write((const char*)mips, (std::streamsize)(mipCount * sizeof(Mip)));
+        written += mipCount * sizeof(Mip);
+
+        std::vector<uint8_t> level((const uint8_t*)rgba, rgba + (size_t)width * height * 4);
+        std::vector<uint8_t> next;
+        std::vector<uint8_t> blocks;
+        for (uint32_t i = 0; i < mipCount; ++i) {
+            if (i > 0) {
+                Downsample(level, mips[i - 1].width, mips[i - 1].height, next);
+                level.swap(next);
+            }
+
+            blocks.resize(mips[i].size);
+            CompressLevel(level.data(), mips[i].width, mips[i].height, encoding, blocks.data());
+
+            padTo(mips[i].offset);
+            out.write((const char*)blocks.data(), (std::streamsize)blocks.size());
+            written += blocks.size();
+        }
+
+        padTo(header.totalSize);
+        return out.good();
+    }
+
+    bool Parse(const uint8_t* data, size_t size, View& view) {
+        if (data == nullptr || size < sizeof(Header)) return false;
+
+        const Header* header = reinterpret_cast<const Header*>(data);
+        if (header->magic != MAGIC || header->version != VERSION) return false;
+        if (header->encoding < ENCODING_BC1 || header->encoding > ENCODING_BC4) return false;
+        if (header->mipCount == 0 || header->mipCount > MAX_MIPS) return false;
+        if (header->totalSize > size) return false;
+
+        uint64_t total = header->totalSize;
+        uint64_t tableBytes = (uint64_t)header->mipCount * sizeof(Mip);
+        if (header->mipsOffset % MeshFormat::SECTION_ALIGNMENT != 0 || header->mipsOffset > total || tableBytes > total - header->mipsOffset) {
+            return false;
+        }
+
+        const Mip* mips = reinterpret_cast<const Mip*>(data + header->mipsOffset);
+        for (uint32_t level = 0; level < header->mipCount; ++level) {
+            const Mip& mip = mips[level];
+            if (mip.width != std::max(1u, header->width >> level) || mip.height != std::max(1u, header->height >> level)) return false;
+            if (mip.size != ComputeMipSize(header->encoding, mip.width, mip.height)) return false;
+            if (mip.offset > total || mip.size > total - mip.offset) return false;
+        }
+
+        view.header = header;
+        view.mips = mips;
+        view.data = data;
+        return true;
+    }
+
+    bool IsCurrent(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+
+        Header header = {};
+        if (!file.read((char*)&header, sizeof(Header))) return false;
+
+        return header.magic == MAGIC && header.version == VERSION;
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <ostream>
+
+// Binary layout of a texture stored in Assets/Library.
+//
+//   [Header][Mip table][Mip 0 blocks][Mip 1 blocks]...
+//
+// The whole mip chain is generated and block-compressed at import time, so
+// the loader maps the file and hands each level straight to
+// glCompressedTexImage2D: no image decoding and no glGenerateMipmap.
+// Encoding depends on the source: BC1 for opaque color, BC3 when there is a
+// real alpha channel and BC4 for single channel images (still sampled as red,
+// same as the GL_RED upload of the stb_image path).
+namespace TextureFormat {
+
+    constexpr uint32_t MAGIC = 0x58455456; // "VTEX"
+    constexpr uint32_t VERSION = 1;
+    constexpr uint32_t MAX_MIPS = 16;
+
+    enum Encoding : uint32_t {
+        ENCODING_BC1 = 1,
+        ENCODING_BC3 = 2,
+        ENCODING_BC4 = 3
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t encoding;
+        uint32_t width;
+        uint32_t height;
+        uint32_t mipCount;
+        uint32_t sourceChannels;
+        uint32_t reserved;
+        uint64_t mipsOffset;
+        uint64_t totalSize;
+    };
+
+    struct Mip {
+        uint64_t offset;   // from the start of the header
+        uint32_t size;
+        uint32_t width;
+        uint32_t height;
+        uint32_t reserved;
+    };
+
+    struct View {
+        const Header* header = nullptr;
+        const Mip* mips = nullptr;
+        const uint8_t* data = nullptr;   // start of the blob, mips[i].offset is relative to it
+
+        const uint8_t* GetMipData(uint32_t level) const { return data + mips[level].offset; }
+    };
+
+    uint32_t GetBlockSize(uint32_t encoding);
+    uint64_t ComputeMipSize(uint32_t encoding, uint32_t width, uint32_t height);
+
+    // rgba: width*height*4 bytes, top row first. sourceChannels picks the encoding
+    bool Write(std::ostream& out, const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t sourceChannels);
+
+    bool Parse(const uint8_t* data, size_t size, View& view);
+
+    bool IsCurrent(const std::string& path);
+}
@@ -0,0 +1,300 @@
+#include "TextureStreamer.h"
+#include "Log.h"
+#include "stb_image.h"
+#include "Textures.h"
+#include "TextureFormat.h"
+#include "MappedFile.h"
+#include "ResMan.h"
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+using Clock = std::chrono::steady_clock;
+
+static GLenum FormatFromChannels(int channels) {
+    if (channels == 1) return GL_RED;
+    if (channels == 4) return GL_RGBA;
+    return GL_RGB;
+}
+
+TextureStreamer::~TextureStreamer() {
+    Stop();
+}
+
+void TextureStreamer::Start(unsigned int workerCount) {
+    if (!workers.empty()) return;
+
+    if (workerCount == 0) {
+        unsigned int cores = std::thread::hardware_concurrency();
+        workerCount = cores > 1 ? cores - 1 : 1;
+    }
+
+    stopping = false;
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&TextureStreamer::WorkerLoop, this);
+    }
+    LOG("[Textures] Streaming with %u decode threads", workerCount);
+}
+
+void TextureStreamer::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    decodeReady.notify_all();
+    uploadSpace.notify_all();
+
+    for (auto& worker : workers) worker.join();
+    workers.clear();
+
+    // Lo que no llego a subirse se descarta. Las texturas/PBO de GL se van con el contexto
+    for (auto& image : uploadQueue) stbi_image_free(image.pixels);
+    uploadQueue.clear();
+    decodeQueue.clear();
+}
+
+GLuint TextureStreamer::Request(const std::string& filePath, bool flipVertically) {
+    GLuint id = 0;
+    glGenTextures(1, &id);
+    UploadPlaceholder(id);
+    TextureInfo& info = infos[id];
+    info = TextureInfo();
+    info.ticket = nextTicket++;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        decodeQueue.push_back({ id, info.ticket, filePath, flipVertically });
+    }
+    decodeReady.notify_one();
+    return id;
+}
+
+void TextureStreamer::WorkerLoop() {
+    while (true) {
+        DecodeJob job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            decodeReady.wait(lock, [this] { return stopping || !decodeQueue.empty(); });
+            if (stopping) return;
+
+            job = std::move(decodeQueue.front());
+            decodeQueue.pop_front();
+            ++decoding;
+        }
+
+        DecodedImage image;
+        image.id = job.id;
+        image.ticket = job.ticket;
+        image.path = std::move(job.path);
+
+        // Library: solo mapear, los mips ya estan comprimidos. Se guarda sin girar, asi que los obj van por stb
+        std::string libPath;
+        if (!job.flipVertically && !job.skipLibrary && ResourceManager::GetInstance().FindLibraryFile(image.path, libPath)) {
+            auto file = std::make_shared<MappedFile>();
+            TextureFormat::View view;
+            if (file->Open(libPath) && TextureFormat::Parse(file->GetData(), file->GetSize(), view)) {
+                image.width = (int)view.header->width;
+                image.height = (int)view.header->height;
+                image.library = file;
+            }
+        }
+
+        // El flag de flip de stb es global; cada hilo usa el que habia cuando se pidio la textura
+        if (!image.library) {
+            stbi_set_flip_vertically_on_load_thread(job.flipVertically);
+            image.pixels = stbi_load(image.path.c_str(), &image.width, &image.height, &image.channels, 0);
+        }
+        if (!image.pixels && !image.library) {
+            LOG("[Textures] ERROR: No se pudo cargar: %s (%s)", image.path.c_str(), stbi_failure_reason());
+        }
+
+        {
+            // Cola acotada: si el main thread va atrasado no acumulamos imagenes decodificadas en RAM
+            std::unique_lock<std::mutex> lock(mutex);
+            uploadSpace.wait(lock, [this] { return stopping || uploadQueue.size() < maxDecodedInFlight; });
+            --decoding;
+            if (stopping) {
+                stbi_image_free(image.pixels);
+                return;
+            }
+            uploadQueue.push_back(std::move(image));
+        }
+    }
+}
+
+void TextureStreamer::ProcessUploads() {
+    stats.lastFrameUploads = 0;
+    stats.lastFrameUploadMs = 0.0;
+
+    auto start = Clock::now();
+    while (true) {
+        DecodedImage image;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (uploadQueue.empty()) break;
+            image = std::move(uploadQueue.front());
+            uploadQueue.pop_front();
+        }
+        uploadSpace.notify_one();
+
+        if (image.library) {
+            if (Upload(image)) {
+                stats.uploaded++;
+                stats.uploadedCompressed++;
+            }
+            else {
+                DecodeSource(image);
+            }
+        }
+        else if (image.pixels) {
+            if (Upload(image)) stats.uploaded++;
+            stbi_image_free(image.pixels);
+        }
+        else {
+            // Se queda con el placeholder
+            stats.failed++;
+        }
+        stats.lastFrameUploads++;
+
+        // Siempre sube al menos una por frame para que una textura enorme no se quede atascada
+        stats.lastFrameUploadMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (stats.lastFrameUploadMs >= uploadBudgetMs) break;
+    }
+}
+
+bool TextureStreamer::Upload(const DecodedImage& image) {
+    // La textura se pudo borrar (y su id reutilizarse) mientras se decodificaba
+    auto it = infos.find(image.id);
+    if (it == infos.end() || it->second.ticket != image.ticket) return false;
+
+    if (image.library) {
+        TextureFormat::View view;
+        if (!TextureFormat::Parse(image.library->GetData(), image.library->GetSize(), view) || !Texture::UploadCompressed(image.id, view)) return false;
+
+        it->second.width = image.width;
+        it->second.height = image.height;
+        it->second.resident = true;
+        return true;
+    }
+
+    GLenum format = FormatFromChannels(image.channels);
+    size_t bytes = (size_t)image.width * image.height * image.channels;
+
+    glBindTexture(GL_TEXTURE_2D, image.id);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    bool uploaded = false;
+    if (usePixelBuffers) {
+        // PBO huerfano por subida: el driver copia desde el buffer cuando le va bien en vez de bloquear aqui
+        if (pixelBuffer == 0) glGenBuffers(1, &pixelBuffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)bytes, nullptr, GL_STREAM_DRAW);
+        void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (mapped) {
+            memcpy(mapped, image.pixels, bytes);
+            if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER)) {
+                glTexImage2D(GL_TEXTURE_2D, 0, format, image.width, image.height, 0, format, GL_UNSIGNED_BYTE, nullptr);
+                uploaded = true;
+            }
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    if (!uploaded) {
+        glTexImage2D(GL_TEXTURE_2D, 0, format, image.width, image.height, 0, format, GL_UNSIGNED_BYTE, image.pixels);
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+    // Misma configuracion que Texture::TextureFromFile
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    TextureInfo& info = it->second;
+    info.width = image.width;
+    info.height = image.height;
+    info.resident = true;
+    return true;
+}
+
+void TextureStreamer::DecodeSource(const DecodedImage& image) {
+    auto it = infos.find(image.id);
+    if (it == infos.end() || it->second.ticket != image.ticket) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        decodeQueue.push_back({ image.id, image.ticket, image.path, false, true });
+    }
+    decodeReady.notify_one();
+}
+
+void TextureStreamer::LoadPlaceholder() {
+    placeholderLoaded = true;
+
+    int width, height, channels;
+    stbi_set_flip_vertically_on_load_thread(false);
+    unsigned char* data = stbi_load(placeholderPath.c_str(), &width, &height, &channels, 0);
+    if (data) {
+        placeholderPixels.assign(data, data + (size_t)width * height * channels);
+        placeholderW = width;
+        placeholderH = height;
+        placeholderChannels = channels;
+        stbi_image_free(data);
+        return;
+    }
+
+    // Sin checkers.jpg generamos un damero 8x8 para que se vea igualmente que falta la textura
+    LOG("[Textures] No se pudo cargar el placeholder %s, usando damero generado", placeholderPath.c_str());
+    placeholderW = placeholderH = 8;
+    placeholderChannels = 3;
+    placeholderPixels.resize(8 * 8 * 3);
+    for (int y = 0; y < 8; ++y) {
+        for (int x = 0; x < 8; ++x) {
+            unsigned char value = ((x + y) & 1) ? 255 : 0;
+            memset(&placeholderPixels[(y * 8 + x) * 3], value, 3);
+        }
+    }
+}
+
+void TextureStreamer::UploadPlaceholder(GLuint id) {
+    if (!placeholderLoaded) LoadPlaceholder();
+
+    GLenum format = FormatFromChannels(placeholderChannels);
+    glBindTexture(GL_TEXTURE_2D, id);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, format, placeholderW, placeholderH, 0, format, GL_UNSIGNED_BYTE, placeholderPixels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // Sin mipmaps: asi no pagamos glGenerateMipmap por algo que se va a sustituir
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+void TextureStreamer::Forget(GLuint id) {
+    infos.erase(id);
+}
+
+bool TextureStreamer::IsResident(GLuint id) const {
+    auto it = infos.find(id);
+    return it != infos.end() && it->second.resident;
+}
+
+bool TextureStreamer::GetSize(GLuint id, int& width, int& height) const {
+    auto it = infos.find(id);
+    if (it == infos.end() || !it->second.resident) return false;
+    width = it->second.width;
+    height = it->second.height;
+    return true;
+}
+
+TextureStreamer::Stats TextureStreamer::GetStats() const {
+    Stats result = stats;
+    std::lock_guard<std::mutex> lock(mutex);
+    result.pendingDecodes = decodeQueue.size() + decoding;
+    result.pendingUploads = uploadQueue.size();
+    return result;
+}
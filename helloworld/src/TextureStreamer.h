@@ -0,0 +1,116 @@
+#pragma once
+#include <string>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <cstdint>
+#include <memory>
+#include "glad/glad.h"
+
+class MappedFile;
+
+// Asynchronous texture loading.
+//
+// Request() creates the GL texture straight away and fills it with the
+// placeholder (checkers) image, so every copy of the returned id can be bound
+// from the first frame. Background threads map the pre-compressed Library
+// texture when there is one (see TextureFormat.h) or decode the file with stb_image, and
+// park the pixels in a bounded queue; ProcessUploads() runs on the main thread
+// once per frame and uploads as many of them as fit in uploadBudgetMs,
+// replacing the placeholder contents of the same texture id in place.
+class TextureStreamer {
+public:
+
+    struct Stats {
+        size_t pendingDecodes = 0;
+        size_t pendingUploads = 0;
+        uint64_t uploaded = 0;
+        uint64_t uploadedCompressed = 0;  // straight from Library, no decode
+        uint64_t failed = 0;
+        uint32_t lastFrameUploads = 0;
+        double lastFrameUploadMs = 0.0;
+    };
+
+    TextureStreamer() = default;
+    ~TextureStreamer();
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    // workerCount 0 = hardware_concurrency - 1 (the main thread keeps rendering)
+    void Start(unsigned int workerCount = 0);
+    void Stop();
+
+    // Main thread only (needs the GL context)
+    GLuint Request(const std::string& filePath, bool flipVertically);
+    void ProcessUploads();
+
+    // The texture was deleted: a decode still in flight for it must not be uploaded
+    void Forget(GLuint id);
+
+    bool IsResident(GLuint id) const;
+    bool GetSize(GLuint id, int& width, int& height) const;
+    Stats GetStats() const;
+
+    float uploadBudgetMs = 2.0f;
+    bool usePixelBuffers = true;
+    size_t maxDecodedInFlight = 16;  // decoded images waiting for upload; workers block beyond this
+    std::string placeholderPath;
+
+private:
+
+    // GL reuses deleted ids, so uploads are matched by ticket and not only by id
+    struct DecodeJob {
+        GLuint id;
+        uint64_t ticket;
+        std::string path;
+        bool flipVertically;
+        bool skipLibrary = false;     // the Library blob was rejected by the driver, decode the source
+    };
+
+    struct DecodedImage {
+        GLuint id = 0;
+        uint64_t ticket = 0;
+        std::string path;
+        unsigned char* pixels = nullptr;
+        int width = 0, height = 0, channels = 0;
+        std::shared_ptr<MappedFile> library;  // set instead of pixels for Library textures
+    };
+
+    struct TextureInfo {
+        uint64_t ticket = 0;
+        int width = 0, height = 0;
+        bool resident = false;
+    };
+
+    void WorkerLoop();
+    // False when nothing was uploaded (the texture was released or reloaded meanwhile)
+    bool Upload(const DecodedImage& image);
+    // Sends a Library texture the driver could not take back to the workers, to be decoded with stb
+    void DecodeSource(const DecodedImage& image);
+    void UploadPlaceholder(GLuint id);
+    void LoadPlaceholder();
+
+    std::vector<std::thread> workers;
+    bool stopping = false;
+
+    // Shared with the workers
+    mutable std::mutex mutex;
+    std::condition_variable decodeReady;
+    std::condition_variable uploadSpace;
+    std::deque<DecodeJob> decodeQueue;
+    std::deque<DecodedImage> uploadQueue;
+    size_t decoding = 0;
+
+    // Main thread only
+    std::unordered_map<GLuint, TextureInfo> infos;
+    uint64_t nextTicket = 1;
+    std::vector<unsigned char> placeholderPixels;
+    int placeholderW = 0, placeholderH = 0, placeholderChannels = 0;
+    bool placeholderLoaded = false;
+    GLuint pixelBuffer = 0;
+    Stats stats;
+};
@@ -5,13 +5,47 @@
 #include <string>
 #include <algorithm>
 #include <iostream>
+#include <cstring>
 #include "FileSystem.h"
+#include "TextureStreamer.h"
+#include "TextureCache.h"
+#include "TextureFormat.h"
+#include "MappedFile.h"
+#include "ResMan.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
 using namespace std;
 
+// S3TC no es core en GL; los valores son los de EXT_texture_compression_s3tc
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+// Se mira una vez (hace falta el contexto GL). RGTC (BC4) es core desde GL 3.0
+static bool HasS3TC() {
+    static int supported = -1;
+    if (supported < 0) {
+        supported = 0;
+        GLint extensionCount = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+        for (GLint i = 0; i < extensionCount; i++) {
+            const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+            if (extension && strcmp(extension, "GL_EXT_texture_compression_s3tc") == 0) {
+                supported = 1;
+                break;
+            }
+        }
+        if (!supported)
+            LOG("[Textures] Sin GL_EXT_texture_compression_s3tc: las texturas de Library BC1/BC3 se decodifican con stb");
+    }
+    return supported == 1;
+}
+
 Texture::Texture() : Module()
 {
     name = "textures";
@@ -23,11 +57,27 @@ Texture::Texture() : Module()
 }
 
 Texture::~Texture() {}
-bool Texture::Awake() { return true; }
+bool Texture::Awake() {
+    // Solo el modulo de la Application tiene streamer; las copias de Texture lo comparten
+    streamer = std::make_shared<TextureStreamer>();
+    streamer->placeholderPath = defaultTexDir;
+    streamer->Start();
+    cache = std::make_shared<TextureCache>();
+    return true;
+}
 bool Texture::Start() { return true; }
-bool Texture::CleanUp() { return true; }
+bool Texture::PreUpdate() {
+    // Subidas pendientes antes de que se pinte nada este frame
+    if (streamer) streamer->ProcessUploads();
+    return true;
+}
+bool Texture::CleanUp() {
+    if (streamer) streamer->Stop();
+    return true;
+}
 
-uint Texture::TextureFromFile(const string directory, const char* filename) {
+// Une directorio + archivo tal y como lo esperan las rutas que guarda Model
+static std::string BuildTexturePath(const string& directory, const char* filename) {
 
     std::string editedDirectory = directory;
     std::replace(editedDirectory.begin(), editedDirectory.end(), '\\', '/');
@@ -47,12 +97,34 @@ uint Texture::TextureFromFile(const string directory, const char* filename) {
         filePath = editedDirectory + filename;
     }
 
+    return filePath;
+}
+
+uint Texture::TextureFromFile(const string directory, const char* filename, bool flipVertically) {
+
+    std::string filePath = BuildTexturePath(directory, filename);
+
     glGenTextures(1, &id);
+    path = filePath;
+
+    // Library primero: mips ya comprimidos, sin decodificar. Las texturas giradas (obj) siguen por stb
+    std::string libPath;
+    if (!flipVertically && ResourceManager::GetInstance().FindLibraryFile(filePath, libPath)) {
+        MappedFile file;
+        TextureFormat::View view;
+        if (file.Open(libPath) && TextureFormat::Parse(file.GetData(), file.GetSize(), view) && UploadCompressed(id, view)) {
+            texW = view.header->width;
+            texH = view.header->height;
+            return id;
+        }
+    }
+
     glBindTexture(GL_TEXTURE_2D, id);
 
     int width, height, nChannels;
 
-    // Cargar imagen
+    // Cargar imagen. El flip de stb es por hilo: se pone en cada carga, no se hereda de otra
+    stbi_set_flip_vertically_on_load_thread(flipVertically);
     unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &nChannels, 0);
 
     if (data)
@@ -88,6 +160,51 @@ uint Texture::TextureFromFile(const string directory, const char* filename) {
         stbi_image_free(data);
     }
 
+    return id;
+}
+
+uint Texture::TextureFromFileAsync(const string directory, const char* filename, bool flipVertically) {
+    std::string filePath = BuildTexturePath(directory, filename);
+
+    auto textureModule = Application::GetInstance().textures;
+    if (!textureModule || !textureModule->streamer) return TextureFromFile(directory, filename, flipVertically);
+
+    id = textureModule->streamer->Request(filePath, flipVertically);
     path = filePath;
     return id;
-}
\ No newline at end of file
+}
+
+bool Texture::UploadCompressed(uint id, const TextureFormat::View& view) {
+    GLenum internalFormat;
+    switch (view.header->encoding) {
+    case TextureFormat::ENCODING_BC1: internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT; break;
+    case TextureFormat::ENCODING_BC3: internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+    case TextureFormat::ENCODING_BC4: internalFormat = GL_COMPRESSED_RED_RGTC1; break;
+    default: return false;
+    }
+    if (internalFormat != GL_COMPRESSED_RED_RGTC1 && !HasS3TC()) return false;
+
+    // Errores de antes no son nuestros; uno despues de los mips = el driver no acepto los datos
+    while (glGetError() != GL_NO_ERROR) {}
+
+    glBindTexture(GL_TEXTURE_2D, id);
+    for (uint32_t level = 0; level < view.header->mipCount; ++level) {
+        const TextureFormat::Mip& mip = view.mips[level];
+        glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)level, internalFormat, (GLsizei)mip.width, (GLsizei)mip.height, 0,
+            (GLsizei)mip.size, view.GetMipData(level));
+    }
+
+    GLenum error = glGetError();
+    if (error != GL_NO_ERROR) {
+        LOG("[Textures] glCompressedTexImage2D fallo (0x%04X), se decodifica la imagen original", error);
+        return false;
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)view.header->mipCount - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    return true;
+}
@@ -3,9 +3,14 @@
 #include "Module.h"
 #include <string>
 #include <vector>
+#include <memory>
 
 using namespace std;
 
+class TextureStreamer;
+class TextureCache;
+namespace TextureFormat { struct View; }
+
 
 class Texture : public Module
 {
@@ -20,9 +25,19 @@ public:
 
 	bool Start();
 
+	bool PreUpdate();
+
 	bool CleanUp();
 
-	uint TextureFromFile(std::string directory, const char* filename);
+	// flipVertically: stb turns the image upside down (obj models)
+	uint TextureFromFile(std::string directory, const char* filename, bool flipVertically = false);
+
+	// Returns at once with the checkers placeholder bound to 'id'; the real image
+	// is decoded on a worker and uploaded into the same id a few frames later
+	uint TextureFromFileAsync(std::string directory, const char* filename, bool flipVertically = false);
+
+	// Uploads a pre-baked Library texture (every mip, block compressed) into 'id'
+	static bool UploadCompressed(uint id, const TextureFormat::View& view);
 
 	
 
@@ -34,9 +49,12 @@ public:
 	std::string path;
 	int texW, texH;
 
-	std::vector<Texture> textures_loaded;
-
 	std::string defaultTexDir = "../Assets/Textures/checkers.jpg";
+
+	// Decode threads + upload queue, only created for the Application module
+	std::shared_ptr<TextureStreamer> streamer;
+	// Every texture in use, by path (meshes/materials hold TextureHandles)
+	std::shared_ptr<TextureCache> cache;
 	
 	
 };
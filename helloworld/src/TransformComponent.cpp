@@ -1,17 +1,32 @@
 #include "TransformComponent.h"
 #include "GameObject.h"
+#include "RenderMeshComponent.h"
 #include <glm/gtx/euler_angles.hpp>
 #include <glm/gtx/transform.hpp>
 
+static TransformComponent* GetTransform(const std::shared_ptr<GameObject>& go) {
+    return go ? go->GetComponent<TransformComponent>() : nullptr;
+}
+
 TransformComponent::TransformComponent(std::shared_ptr<GameObject> ownerPtr)
-    : Component(ownerPtr, ComponentType::TRANSFORM),
-    localPosition(0.0f, 0.0f, 0.0f),
-    localRotation(1.0f, 0.0f, 0.0f, 0.0f), // Identity quaternion
-    localScale(1.0f, 1.0f, 1.0f),
-    localMatrix(1.0f),
-    globalMatrix(1.0f),
-    isDirty(true),
-    isGlobalDirty(true) {
+    : Component(ownerPtr, ComponentType::TRANSFORM) {
+    TransformSystem& system = TransformSystem::GetInstance();
+    handle = system.Create(this);
+
+    // The hierarchy may already exist (transform added after SetParent)
+    if (ownerPtr) {
+        if (auto parentTransform = GetTransform(ownerPtr->GetParent()))
+            system.SetParent(handle, parentTransform->handle);
+
+        for (auto& child : ownerPtr->GetChildren()) {
+            if (auto childTransform = GetTransform(child))
+                system.SetParent(childTransform->handle, handle);
+        }
+    }
+}
+
+TransformComponent::~TransformComponent() {
+    TransformSystem::GetInstance().Destroy(handle);
 }
 
 void TransformComponent::Enable() {
@@ -20,7 +35,7 @@ void TransformComponent::Enable() {
 
 void TransformComponent::Update() {
     // Transform doesn't need per-frame updates
-    // Matrices are calculated on-demand
+    // World matrices are computed in batch by TransformSystem::Update()
 }
 
 void TransformComponent::Disable() {}
@@ -28,28 +43,24 @@ void TransformComponent::Disable() {}
 void TransformComponent::OnEditor() {}
 
 void TransformComponent::SetPosition(const glm::vec3& pos) {
-    localPosition = pos;
-    MarkAsDirty();
+    TransformSystem::GetInstance().SetPosition(handle, pos);
 }
 
 void TransformComponent::SetRotation(const glm::quat& rot) {
-    localRotation = rot;
-    MarkAsDirty();
+    TransformSystem::GetInstance().SetRotation(handle, rot);
 }
 
 void TransformComponent::SetRotation(const glm::vec3& euler) {
     glm::vec3 radians = glm::radians(euler);
-    localRotation = glm::quat(radians);
-    MarkAsDirty();
+    TransformSystem::GetInstance().SetRotation(handle, glm::quat(radians));
 }
 
 void TransformComponent::SetScale(const glm::vec3& scl) {
-    localScale = scl;
-    MarkAsDirty();
+    TransformSystem::GetInstance().SetScale(handle, scl);
 }
 
 glm::vec3 TransformComponent::GetEulerAngles() const {
-    return glm::degrees(glm::eulerAngles(localRotation));
+    return glm::degrees(glm::eulerAngles(GetRotation()));
 }
 
 glm::vec3 TransformComponent::GetWorldPosition() const {
@@ -57,90 +68,38 @@ glm::vec3 TransformComponent::GetWorldPosition() const {
 }
 
 glm::quat TransformComponent::GetWorldRotation() const {
-    if (auto go = owner.lock()) {
-        if (auto parent = go->GetParent()) {
-            auto parentTransform = std::dynamic_pointer_cast<TransformComponent>(
-                parent->GetComponent(ComponentType::TRANSFORM)
-            );
-            if (parentTransform) {
-                return parentTransform->GetWorldRotation() * localRotation;
-            }
-        }
-    }
-    return localRotation;
+    return TransformSystem::GetInstance().GetWorldRotation(handle);
 }
 
 glm::vec3 TransformComponent::GetWorldScale() const {
-    if (auto go = owner.lock()) {
-        if (auto parent = go->GetParent()) {
-            auto parentTransform = std::dynamic_pointer_cast<TransformComponent>(
-                parent->GetComponent(ComponentType::TRANSFORM)
-            );
-            if (parentTransform) {
-                return parentTransform->GetWorldScale() * localScale;
-            }
-        }
-    }
-    return localScale;
+    return TransformSystem::GetInstance().GetWorldScale(handle);
 }
 
 glm::mat4 TransformComponent::GetLocalTransform() const {
-    if (isDirty) RecalculateMatrices();
-    return localMatrix;
+    return TransformSystem::GetInstance().GetLocalMatrix(handle);
 }
 
 glm::mat4 TransformComponent::GetGlobalTransform() const {
-    if (isGlobalDirty) RecalculateGlobalMatrixRecursive();
-    return globalMatrix;
+    return TransformSystem::GetInstance().GetWorldMatrix(handle);
 }
 
 void TransformComponent::MarkAsDirty() {
-    isDirty = true;
-    isGlobalDirty = true;
-
-    if (auto go = owner.lock()) {
-        for (auto& child : go->GetChildren()) {
-            auto childTransform = std::dynamic_pointer_cast<TransformComponent>(
-                child->GetComponent(ComponentType::TRANSFORM)
-            );
-            if (childTransform) {
-                childTransform->isGlobalDirty = true;
-            }
-        }
-    }
+    TransformSystem::GetInstance().MarkDirty(handle);
 }
 
-void TransformComponent::RecalculateMatrices() const {
-    glm::mat4 translation = glm::translate(glm::mat4(1.0f), localPosition);
-    glm::mat4 rotation = glm::mat4_cast(localRotation);
-    glm::mat4 scale = glm::scale(glm::mat4(1.0f), localScale);
+void TransformComponent::SyncParent() {
+    TransformComponent* parentTransform = nullptr;
+    if (auto go = owner.lock())
+        parentTransform = GetTransform(go->GetParent());
 
-    localMatrix = translation * rotation * scale;
-    isDirty = false;
+    TransformSystem::GetInstance().SetParent(handle,
+        parentTransform ? parentTransform->handle : TransformSystem::InvalidHandle);
 }
 
-void TransformComponent::RecalculateGlobalMatrixRecursive() const {
-    if (isDirty) RecalculateMatrices();
-
+// children don't need to be visited: the system already updates them in the same pass
+void TransformComponent::OnWorldChanged() {
     if (auto go = owner.lock()) {
-        if (auto parent = go->GetParent()) {
-            auto parentTransform = std::dynamic_pointer_cast<TransformComponent>(
-                parent->GetComponent(ComponentType::TRANSFORM)
-            );
-            if (parentTransform) {
-                globalMatrix = parentTransform->GetGlobalTransform() * localMatrix;
-            }
-            else {
-                globalMatrix = localMatrix;
-            }
-        }
-        else {
-            globalMatrix = localMatrix;
-        }
+        if (auto renderer = go->GetComponent<RenderMeshComponent>())
+            renderer->MarkBoundsDirty();
     }
-    else {
-        globalMatrix = localMatrix;
-    }
-
-    isGlobalDirty = false;
-}
\ No newline at end of file
+}
@@ -2,6 +2,8 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include "Component.h"
 #include "glm/glm.hpp"
+#include <cstdint>
+#include "TransformSystem.h"
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -9,7 +11,7 @@ class TransformComponent : public Component {
 
 public:
     TransformComponent(std::shared_ptr<GameObject> owner);
-    ~TransformComponent() override = default;
+    ~TransformComponent() override;
 
     // Component interface pa la lara
     void Enable() override;
@@ -22,9 +24,9 @@ public:
     void SetRotation(const glm::vec3& euler); 
     void SetScale(const glm::vec3& scl);
 
-    glm::vec3 GetPosition() const { return localPosition; }
-    glm::quat GetRotation() const { return localRotation; }
-    glm::vec3 GetScale() const { return localScale; }
+    glm::vec3 GetPosition() const { return TransformSystem::GetInstance().GetPosition(handle); }
+    glm::quat GetRotation() const { return TransformSystem::GetInstance().GetRotation(handle); }
+    glm::vec3 GetScale() const { return TransformSystem::GetInstance().GetScale(handle); }
     glm::vec3 GetEulerAngles() const; // Returns in degrees
 
     // World space transforms
@@ -39,18 +41,20 @@ public:
     // Mark transform as dirty (needs recalculation)
     void MarkAsDirty();
 
+    // Bumped every time the global matrix is recomputed, lets others cache world space data
+    uint32_t GetGlobalVersion() const { return TransformSystem::GetInstance().GetVersion(handle); }
+
+    // Re-reads the owner's parent, called by GameObject whenever it changes
+    void SyncParent();
+
+    TransformSystem::Handle GetHandle() const { return handle; }
+
 private:
-    void RecalculateMatrices() const;
-    void RecalculateGlobalMatrixRecursive() const;
-
-    // Local transform - DEFINED HERE
-    glm::vec3 localPosition;
-    glm::quat localRotation;
-    glm::vec3 localScale;
-
-    // Cached matrices
-    mutable glm::mat4 localMatrix;
-    mutable glm::mat4 globalMatrix;
-    mutable bool isDirty;
-    mutable bool isGlobalDirty;
+    friend class TransformSystem;
+
+    // Called by TransformSystem::Update() when the world matrix was recomputed
+    void OnWorldChanged();
+
+    // The data itself lives in TransformSystem
+    TransformSystem::Handle handle = TransformSystem::InvalidHandle;
 };
\ No newline at end of file
@@ -0,0 +1,261 @@
+#include "TransformSystem.h"
+#include "TransformComponent.h"
+#include "Log.h"
+#include <algorithm>
+#include <type_traits>
+#include <chrono>
+#include "Profiler.h"
+
+using Clock = std::chrono::steady_clock;
+
+enum TransformFlags : uint8_t {
+    LOCAL_DIRTY = 1,     // TRS changed, local (and world) matrix must be rebuilt
+    WORLD_CHANGED = 2,   // world matrix rebuilt in the current pass, children follow
+    DEAD = 4             // destroyed, removed on the next Reorder()
+};
+
+static constexpr uint32_t NoDense = 0xFFFFFFFFu;
+
+TransformSystem& TransformSystem::GetInstance() {
+    static TransformSystem* instance = new TransformSystem(); // never destroyed on purpose
+    return *instance;
+}
+
+TransformSystem::Handle TransformSystem::Create(TransformComponent* component) {
+    Handle handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    }
+    else {
+        handle = (Handle)denseOf.size();
+        denseOf.push_back(NoDense);
+    }
+
+    denseOf[handle] = (uint32_t)handleOf.size();
+    localPosition.push_back(glm::vec3(0.0f));
+    localRotation.push_back(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+    localScale.push_back(glm::vec3(1.0f));
+    localMatrix.push_back(glm::mat4(1.0f));
+    worldMatrix.push_back(glm::mat4(1.0f));
+    parent.push_back(-1);
+    version.push_back(1);
+    flags.push_back(LOCAL_DIRTY);
+    handleOf.push_back(handle);
+    components.push_back(component);
+
+    pending = true;
+    stats.count++;
+    return handle;
+}
+
+void TransformSystem::Destroy(Handle handle) {
+    if (handle == InvalidHandle || handle >= denseOf.size() || denseOf[handle] == NoDense)
+        return;
+
+    uint32_t dense = denseOf[handle];
+    flags[dense] = DEAD;
+    components[dense] = nullptr;
+    denseOf[handle] = NoDense;
+    freeHandles.push_back(handle);
+
+    // compacted (and orphans turned into roots) before the next pass
+    needsReorder = true;
+    pending = true;
+    stats.count--;
+}
+
+void TransformSystem::SetParent(Handle child, Handle newParent) {
+    uint32_t childDense = denseOf[child];
+    int32_t parentDense = newParent == InvalidHandle ? -1 : (int32_t)denseOf[newParent];
+
+    // refuse cycles (parenting an object to one of its own descendants)
+    for (int32_t p = parentDense; p >= 0; p = parent[p]) {
+        if (p == (int32_t)childDense) {
+            LOG("TransformSystem: ignoring parent that would create a cycle");
+            return;
+        }
+    }
+
+    if (parent[childDense] == parentDense)
+        return;
+
+    parent[childDense] = parentDense;
+    if (parentDense > (int32_t)childDense)
+        needsReorder = true;
+
+    flags[childDense] |= LOCAL_DIRTY;
+    pending = true;
+}
+
+void TransformSystem::SetPosition(Handle handle, const glm::vec3& position) {
+    localPosition[denseOf[handle]] = position;
+    MarkDirty(handle);
+}
+
+void TransformSystem::SetRotation(Handle handle, const glm::quat& rotation) {
+    localRotation[denseOf[handle]] = rotation;
+    MarkDirty(handle);
+}
+
+void TransformSystem::SetScale(Handle handle, const glm::vec3& scale) {
+    localScale[denseOf[handle]] = scale;
+    MarkDirty(handle);
+}
+
+void TransformSystem::MarkDirty(Handle handle) {
+    flags[denseOf[handle]] |= LOCAL_DIRTY;
+    pending = true;
+}
+
+const glm::mat4& TransformSystem::GetLocalMatrix(Handle handle) {
+    if (pending) Update();
+    return localMatrix[denseOf[handle]];
+}
+
+const glm::mat4& TransformSystem::GetWorldMatrix(Handle handle) {
+    if (pending) Update();
+    return worldMatrix[denseOf[handle]];
+}
+
+uint32_t TransformSystem::GetVersion(Handle handle) {
+    if (pending) Update();
+    return version[denseOf[handle]];
+}
+
+glm::quat TransformSystem::GetWorldRotation(Handle handle) const {
+    int32_t i = (int32_t)denseOf[handle];
+    glm::quat rotation = localRotation[i];
+    for (int32_t p = parent[i]; p >= 0; p = parent[p])
+        rotation = localRotation[p] * rotation;
+    return rotation;
+}
+
+glm::vec3 TransformSystem::GetWorldScale(Handle handle) const {
+    int32_t i = (int32_t)denseOf[handle];
+    glm::vec3 scale = localScale[i];
+    for (int32_t p = parent[i]; p >= 0; p = parent[p])
+        scale = localScale[p] * scale;
+    return scale;
+}
+
+void TransformSystem::Update() {
+    PROFILE_SCOPE("TransformSystem::Update");
+    if (!pending)
+        return;
+
+    auto start = Clock::now();
+    if (needsReorder)
+        Reorder();
+
+    // Single pass: parents are always earlier in the arrays, so their world
+    // matrix (and WORLD_CHANGED flag) is final by the time a child reads it
+    uint32_t updated = 0;
+    size_t count = handleOf.size();
+    for (size_t i = 0; i < count; i++) {
+        uint8_t f = flags[i];
+        int32_t p = parent[i];
+        bool parentChanged = p >= 0 && (flags[p] & WORLD_CHANGED);
+
+        if (f & LOCAL_DIRTY) {
+            // T * R * S without the two full matrix products
+            glm::mat4 m = glm::mat4_cast(localRotation[i]);
+            m[0] *= localScale[i].x;
+            m[1] *= localScale[i].y;
+            m[2] *= localScale[i].z;
+            m[3] = glm::vec4(localPosition[i], 1.0f);
+            localMatrix[i] = m;
+        }
+
+        if ((f & LOCAL_DIRTY) || parentChanged) {
+            worldMatrix[i] = p >= 0 ? worldMatrix[p] * localMatrix[i] : localMatrix[i];
+            version[i]++;
+            flags[i] = WORLD_CHANGED;
+            updated++;
+            components[i]->OnWorldChanged();
+        }
+        else {
+            flags[i] = 0;
+        }
+    }
+
+    pending = false;
+    stats.lastUpdated = updated;
+    stats.updates++;
+    stats.lastUpdateMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Drops destroyed entries and sorts the rest by depth (stable), which puts
+// every parent before its children. O(n), only after reparenting or destroys
+void TransformSystem::Reorder() {
+    size_t count = handleOf.size();
+
+    for (size_t i = 0; i < count; i++) {
+        if (!(flags[i] & DEAD) && parent[i] >= 0 && (flags[parent[i]] & DEAD)) {
+            parent[i] = -1;             // parent destroyed first: becomes a root
+            flags[i] |= LOCAL_DIRTY;
+        }
+    }
+
+    std::vector<int32_t> depth(count, -1);
+    std::vector<int32_t> chain;
+    int32_t maxDepth = 0;
+    for (size_t i = 0; i < count; i++) {
+        if ((flags[i] & DEAD) || depth[i] >= 0) continue;
+
+        int32_t d = 0;
+        int32_t node = (int32_t)i;
+        chain.clear();
+        while (node >= 0 && depth[node] < 0) {
+            chain.push_back(node);
+            node = parent[node];
+        }
+        d = node >= 0 ? depth[node] + 1 : 0;
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+            depth[*it] = d++;
+        maxDepth = std::max(maxDepth, d - 1);
+    }
+
+    // counting sort by depth
+    std::vector<uint32_t> offsets(maxDepth + 2, 0);
+    for (size_t i = 0; i < count; i++)
+        if (depth[i] >= 0) offsets[depth[i] + 1]++;
+    for (size_t d = 1; d < offsets.size(); d++)
+        offsets[d] += offsets[d - 1];
+
+    size_t alive = offsets.back();
+    std::vector<uint32_t> order(alive);
+    std::vector<int32_t> newIndex(count, -1);
+    for (size_t i = 0; i < count; i++) {
+        if (depth[i] < 0) continue;
+        uint32_t slot = offsets[depth[i]]++;
+        order[slot] = (uint32_t)i;
+        newIndex[i] = (int32_t)slot;
+    }
+
+    auto permute = [&](auto& data) {
+        std::remove_reference_t<decltype(data)> sorted(alive);
+        for (size_t n = 0; n < alive; n++)
+            sorted[n] = data[order[n]];
+        data.swap(sorted);
+    };
+    permute(localPosition);
+    permute(localRotation);
+    permute(localScale);
+    permute(localMatrix);
+    permute(worldMatrix);
+    permute(version);
+    permute(flags);
+    permute(handleOf);
+    permute(components);
+    permute(parent);
+
+    for (size_t n = 0; n < alive; n++) {
+        if (parent[n] >= 0)
+            parent[n] = newIndex[parent[n]];
+        denseOf[handleOf[n]] = (uint32_t)n;
+    }
+
+    needsReorder = false;
+    stats.reorders++;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "glm/glm.hpp"
+#include <glm/gtc/quaternion.hpp>
+
+class TransformComponent;
+
+// Every transform in the scene, stored as parallel arrays (local TRS, local
+// and world matrices, parent index) ordered so that a parent always comes
+// before its children.
+//
+// TransformComponent is only a handle into these arrays. Setters flag the
+// entry; Update() then walks the arrays once, front to back, and recomputes
+// the world matrix of everything that changed or whose parent changed, so
+// each matrix is rebuilt at most once per frame no matter how deep the
+// hierarchy is. Reading a world matrix while changes are pending runs the
+// same pass first, so callers never see stale values.
+class TransformSystem {
+public:
+    using Handle = uint32_t;
+    static constexpr Handle InvalidHandle = 0xFFFFFFFFu;
+
+    struct Stats {
+        size_t count = 0;
+        uint32_t lastUpdated = 0;      // world matrices rebuilt by the last Update()
+        uint32_t updates = 0;          // passes that had something to do
+        uint32_t reorders = 0;         // parent-before-child re-sorts
+        double lastUpdateMs = 0.0;
+    };
+
+    // Lives until the process exits: components may be destroyed during static teardown
+    static TransformSystem& GetInstance();
+
+    Handle Create(TransformComponent* component);
+    void Destroy(Handle handle);
+
+    // InvalidHandle = root. Keeps the local transform (the world one follows the new parent)
+    void SetParent(Handle child, Handle parent);
+
+    void SetPosition(Handle handle, const glm::vec3& position);
+    void SetRotation(Handle handle, const glm::quat& rotation);
+    void SetScale(Handle handle, const glm::vec3& scale);
+    void MarkDirty(Handle handle);
+
+    const glm::vec3& GetPosition(Handle handle) const { return localPosition[denseOf[handle]]; }
+    const glm::quat& GetRotation(Handle handle) const { return localRotation[denseOf[handle]]; }
+    const glm::vec3& GetScale(Handle handle) const { return localScale[denseOf[handle]]; }
+
+    const glm::mat4& GetLocalMatrix(Handle handle);
+    const glm::mat4& GetWorldMatrix(Handle handle);
+    glm::quat GetWorldRotation(Handle handle) const;
+    glm::vec3 GetWorldScale(Handle handle) const;
+    // Bumped every time the world matrix changes
+    uint32_t GetVersion(Handle handle);
+
+    // Once per frame from OpenGL::Update; does nothing when nothing changed
+    void Update();
+
+    bool HasPendingChanges() const { return pending; }
+    const Stats& GetStats() const { return stats; }
+
+private:
+    TransformSystem() = default;
+
+    void Reorder();
+
+    // Indexed by dense position (sorted parent before child)
+    std::vector<glm::vec3> localPosition;
+    std::vector<glm::quat> localRotation;
+    std::vector<glm::vec3> localScale;
+    std::vector<glm::mat4> localMatrix;
+    std::vector<glm::mat4> worldMatrix;
+    std::vector<int32_t> parent;           // dense index, -1 = root
+    std::vector<uint32_t> version;
+    std::vector<uint8_t> flags;
+    std::vector<Handle> handleOf;
+    std::vector<TransformComponent*> components;
+
+    // Indexed by handle
+    std::vector<uint32_t> denseOf;
+    std::vector<Handle> freeHandles;
+
+    bool pending = false;
+    bool needsReorder = false;
+    Stats stats;
+};
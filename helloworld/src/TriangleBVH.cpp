@@ -0,0 +1,258 @@
+#include "TriangleBVH.h"
+#include "Mesh.h"
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include <cmath>
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr int BinCount = 12;
+
+struct Bounds {
+    glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+    glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest());
+
+    void Grow(const glm::vec3& p) { min = glm::min(min, p); max = glm::max(max, p); }
+    void Grow(const Bounds& b) { min = glm::min(min, b.min); max = glm::max(max, b.max); }
+    float Area() const {
+        if (min.x > max.x) return 0.0f;
+        glm::vec3 d = max - min;
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+};
+
+void TriangleBVH::Clear() {
+    nodes.clear();
+    nodes.shrink_to_fit();
+    triangles.clear();
+    triangles.shrink_to_fit();
+}
+
+void TriangleBVH::Build(const Vertex* vertices, const unsigned int* indices, size_t indexCount) {
+    auto start = Clock::now();
+    Clear();
+
+    size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0)
+        return;
+
+    // Per triangle bounds and centroid, only needed while building
+    std::vector<Bounds> triangleBounds(triangleCount);
+    std::vector<glm::vec3> centroids(triangleCount);
+    for (size_t t = 0; t < triangleCount; t++) {
+        const glm::vec3& p0 = vertices[indices[t * 3]].Position;
+        const glm::vec3& p1 = vertices[indices[t * 3 + 1]].Position;
+        const glm::vec3& p2 = vertices[indices[t * 3 + 2]].Position;
+        triangleBounds[t].Grow(p0);
+        triangleBounds[t].Grow(p1);
+        triangleBounds[t].Grow(p2);
+        centroids[t] = (p0 + p1 + p2) / 3.0f;
+    }
+
+    triangles.resize(triangleCount);
+    std::iota(triangles.begin(), triangles.end(), 0u);
+
+    nodes.reserve(2 * (triangleCount / MaxLeafTriangles) + 1);
+    Node root;
+    root.first = 0;
+    root.count = (uint32_t)triangleCount;
+    nodes.push_back(root);
+
+    struct Task { uint32_t node; int depth; };
+    std::vector<Task> tasks;
+    tasks.push_back({ 0, 0 });
+
+    while (!tasks.empty()) {
+        Task task = tasks.back();
+        tasks.pop_back();
+
+        uint32_t first = nodes[task.node].first;
+        uint32_t count = nodes[task.node].count;
+
+        Bounds bounds, centroidBounds;
+        for (uint32_t i = first; i < first + count; i++) {
+            bounds.Grow(triangleBounds[triangles[i]]);
+            centroidBounds.Grow(centroids[triangles[i]]);
+        }
+        nodes[task.node].min = bounds.min;
+        nodes[task.node].max = bounds.max;
+
+        if (count <= MaxLeafTriangles || task.depth >= MaxDepth)
+            continue;
+
+        // Binned SAH, the three axes binned in the same pass over the triangles
+        Bounds binBounds[3][BinCount];
+        uint32_t binCount[3][BinCount] = {};
+        glm::vec3 extent = centroidBounds.max - centroidBounds.min;
+        glm::vec3 scale(
+            extent.x > 0.0f ? BinCount / extent.x : 0.0f,
+            extent.y > 0.0f ? BinCount / extent.y : 0.0f,
+            extent.z > 0.0f ? BinCount / extent.z : 0.0f);
+        for (uint32_t i = first; i < first + count; i++) {
+            uint32_t t = triangles[i];
+            for (int axis = 0; axis < 3; axis++) {
+                int bin = std::min(BinCount - 1, (int)((centroids[t][axis] - centroidBounds.min[axis]) * scale[axis]));
+                binBounds[axis][bin].Grow(triangleBounds[t]);
+                binCount[axis][bin]++;
+            }
+        }
+
+        int bestAxis = -1, bestSplit = 0;
+        float bestCost = std::numeric_limits<float>::max();
+        for (int axis = 0; axis < 3; axis++) {
+            if (extent[axis] <= 0.0f) continue;
+
+            // left side of split s = bins [0..s], right side = bins [s+1..]
+            float leftArea[BinCount - 1], rightArea[BinCount - 1];
+            uint32_t leftCount[BinCount - 1], rightCount[BinCount - 1];
+            Bounds left, right;
+            uint32_t leftSum = 0, rightSum = 0;
+            for (int s = 0; s < BinCount - 1; s++) {
+                left.Grow(binBounds[axis][s]);
+                leftSum += binCount[axis][s];
+                leftArea[s] = left.Area();
+                leftCount[s] = leftSum;
+
+                right.Grow(binBounds[axis][BinCount - 1 - s]);
+                rightSum += binCount[axis][BinCount - 1 - s];
+                rightArea[BinCount - 2 - s] = right.Area();
+                rightCount[BinCount - 2 - s] = rightSum;
+            }
+
+            for (int s = 0; s < BinCount - 1; s++) {
+                float cost = leftCount[s] * leftArea[s] + rightCount[s] * rightArea[s];
+                if (leftCount[s] > 0 && rightCount[s] > 0 && cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = s;
+                }
+            }
+        }
+
+        // splitting doesn't pay off (small nodes only, big ones are always split)
+        float leafCost = count * bounds.Area();
+        if (bestAxis < 0 || (bestCost >= leafCost && count <= 16))
+            continue;
+
+        float splitMin = centroidBounds.min[bestAxis];
+        float splitScale = scale[bestAxis];
+        auto middle = std::partition(triangles.begin() + first, triangles.begin() + first + count, [&](uint32_t t) {
+            int bin = std::min(BinCount - 1, (int)((centroids[t][bestAxis] - splitMin) * splitScale));
+            return bin <= bestSplit;
+        });
+        uint32_t leftCount = (uint32_t)(middle - (triangles.begin() + first));
+        if (leftCount == 0 || leftCount == count)
+            continue;
+
+        uint32_t leftChild = (uint32_t)nodes.size();
+        Node child;
+        child.first = first;
+        child.count = leftCount;
+        nodes.push_back(child);
+        child.first = first + leftCount;
+        child.count = count - leftCount;
+        nodes.push_back(child);
+
+        nodes[task.node].first = leftChild;
+        nodes[task.node].count = 0;
+
+        tasks.push_back({ leftChild, task.depth + 1 });
+        tasks.push_back({ leftChild + 1, task.depth + 1 });
+    }
+
+    buildMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static bool IntersectNode(const glm::vec3& min, const glm::vec3& max, const glm::vec3& origin, const glm::vec3& invDirection, float maxDistance, float& entry) {
+    float tmin = 0.0f, tmax = maxDistance;
+    for (int i = 0; i < 3; i++) {
+        float t0 = (min[i] - origin[i]) * invDirection[i];
+        float t1 = (max[i] - origin[i]) * invDirection[i];
+        if (t0 > t1) std::swap(t0, t1);
+        tmin = t0 > tmin ? t0 : tmin;
+        tmax = t1 < tmax ? t1 : tmax;
+        if (tmax < tmin) return false;
+    }
+    entry = tmin;
+    return true;
+}
+
+bool TriangleBVH::Raycast(const Vertex* vertices, const unsigned int* indices,
+    const glm::vec3& origin, const glm::vec3& direction, float minDistance, float maxDistance, Hit& hit) const {
+    if (nodes.empty())
+        return false;
+
+    glm::vec3 invDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+    float closest = maxDistance;
+    bool found = false;
+
+    struct Entry { uint32_t node; float distance; };
+    Entry stack[MaxDepth + 4];
+    int count = 0;
+
+    float entry;
+    if (!IntersectNode(nodes[0].min, nodes[0].max, origin, invDirection, closest, entry))
+        return false;
+    stack[count++] = { 0, entry };
+
+    while (count > 0) {
+        Entry current = stack[--count];
+        if (current.distance >= closest)
+            continue;
+
+        const Node& node = nodes[current.node];
+        if (node.count > 0) {
+            // Moller-Trumbore, double sided
+            for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                uint32_t t = triangles[i];
+                const glm::vec3& p0 = vertices[indices[t * 3]].Position;
+                glm::vec3 e1 = vertices[indices[t * 3 + 1]].Position - p0;
+                glm::vec3 e2 = vertices[indices[t * 3 + 2]].Position - p0;
+
+                glm::vec3 p = glm::cross(direction, e2);
+                float det = glm::dot(e1, p);
+                if (std::fabs(det) < 1e-12f) continue;
+                float invDet = 1.0f / det;
+
+                glm::vec3 s = origin - p0;
+                float u = glm::dot(s, p) * invDet;
+                if (u < 0.0f || u > 1.0f) continue;
+
+                glm::vec3 q = glm::cross(s, e1);
+                float v = glm::dot(direction, q) * invDet;
+                if (v < 0.0f || u + v > 1.0f) continue;
+
+                float distance = glm::dot(e2, q) * invDet;
+                if (distance > minDistance && distance < closest) {
+                    closest = distance;
+                    hit.distance = distance;
+                    hit.triangle = t;
+                    hit.u = u;
+                    hit.v = v;
+                    found = true;
+                }
+            }
+            continue;
+        }
+
+        // near child last so it is popped first
+        float d0, d1;
+        bool hit0 = IntersectNode(nodes[node.first].min, nodes[node.first].max, origin, invDirection, closest, d0);
+        bool hit1 = IntersectNode(nodes[node.first + 1].min, nodes[node.first + 1].max, origin, invDirection, closest, d1);
+        if (hit0 && hit1) {
+            if (d0 < d1) {
+                stack[count++] = { node.first + 1, d1 };
+                stack[count++] = { node.first, d0 };
+            }
+            else {
+                stack[count++] = { node.first, d0 };
+                stack[count++] = { node.first + 1, d1 };
+            }
+        }
+        else if (hit0) stack[count++] = { node.first, d0 };
+        else if (hit1) stack[count++] = { node.first + 1, d1 };
+    }
+
+    return found;
+}
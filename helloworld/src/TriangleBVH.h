@@ -0,0 +1,57 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "glm/glm.hpp"
+
+struct Vertex;
+
+// Static BVH over the triangles of one mesh, in mesh local space.
+//
+// Built with binned SAH into a flat node array (children stored next to
+// each other) plus a permutation of triangle indices, so the vertex/index
+// data stays where it is (Assimp vectors or the mapped Library file) and
+// only ~40 bytes per triangle are added. Used for exact picking after the
+// scene BVH broad phase.
+class TriangleBVH {
+public:
+
+    struct Hit {
+        float distance = 0.0f;     // along the ray direction as passed in (not renormalized)
+        uint32_t triangle = 0;     // index of the first index of the triangle / 3
+        float u = 0.0f, v = 0.0f;  // barycentrics of vertices 1 and 2
+    };
+
+    // Every index must be a valid vertex: MeshFormat::Parse rejects Library blobs that
+    // break this before a mesh is built from them, Assimp meshes satisfy it already
+    void Build(const Vertex* vertices, const unsigned int* indices, size_t indexCount);
+    void Clear();
+
+    // Closest triangle hit with minDistance < distance < maxDistance. Both sides of triangles count
+    bool Raycast(const Vertex* vertices, const unsigned int* indices,
+        const glm::vec3& origin, const glm::vec3& direction, float minDistance, float maxDistance, Hit& hit) const;
+
+    bool IsBuilt() const { return !nodes.empty(); }
+    size_t GetNodeCount() const { return nodes.size(); }
+    size_t GetTriangleCount() const { return triangles.size(); }
+    size_t GetMemoryUsage() const { return nodes.size() * sizeof(Node) + triangles.size() * sizeof(uint32_t); }
+    double GetBuildMs() const { return buildMs; }
+
+private:
+
+    // count == 0: interior node, children at first and first + 1
+    // count > 0:  leaf, triangles[first .. first + count)
+    struct Node {
+        glm::vec3 min;
+        uint32_t first;
+        glm::vec3 max;
+        uint32_t count;
+    };
+
+    static constexpr uint32_t MaxLeafTriangles = 4;
+    static constexpr int MaxDepth = 60;
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> triangles;
+    double buildMs = 0.0;
+};
@@ -1,11 +1,15 @@
 #include <iostream>
 #include "Application.h"
+#include "Headless.h"
 #include "Log.h"
 
 int main(int argc, char* argv[]) {
 
 	LOG("Engine starting ...");
 
+	if (!Application::GetInstance().headless->ParseArguments(argc, argv))
+		return EXIT_FAILURE;
+
 	//Initializes the engine state
 	Application::EngineState state = Application::EngineState::CREATE;
 	int result = EXIT_FAILURE;
@@ -79,5 +83,9 @@ int main(int argc, char* argv[]) {
 
 	LOG("Closing Engine ===============================");
 
+	//CI: a headless run that couldn't render or write its frames fails
+	if (Application::GetInstance().headless->failed)
+		result = EXIT_FAILURE;
+
 	return result;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Window.h"
 #include "Log.h"
 #include "Application.h"
+#include "Headless.h"
 
 Window::Window() : Module()
 {
@@ -22,6 +23,16 @@ bool Window::Awake()
 	LOG("Init SDL window & surface");
 	bool ret = true;
 
+	//no display: SDL's offscreen driver gets the GL context from EGL (llvmpipe without a GPU)
+	const Headless& headless = *Application::GetInstance().headless;
+	if (headless.enabled)
+	{
+		SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+		width = headless.width;
+		height = headless.height;
+		currentRes = { width, height };
+	}
+
 	if (SDL_Init(SDL_INIT_VIDEO) != true)
 	{
 		LOG("SDL_VIDEO could not initialize! SDL_Error: %s\n", SDL_GetError());
@@ -41,6 +52,15 @@ bool Window::Awake()
 		if (resizable == true)         flags |= SDL_WINDOW_RESIZABLE;
 									   flags |= SDL_WINDOW_OPENGL;
 
+		if (headless.enabled)
+		{
+			//never shown; attributes must be set before the context (the shaders need 4.6 core)
+			flags = SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN;
+			SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+			SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 4);
+			SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 6);
+		}
+
 		// SDL3: SDL_CreateWindow(title, w, h, flags). Set position separately.
 		
 		window = SDL_CreateWindow("Vroom Engine", width, height, flags);
@@ -51,6 +71,14 @@ bool Window::Awake()
 			LOG("Window could not be created! SDL_Error: %s\n", SDL_GetError());
 			ret = false;
 		}
+		else if (headless.enabled)
+		{
+			if (glContext == NULL)
+			{
+				LOG("Headless: no OpenGL 4.6 context from EGL! SDL_Error: %s\n", SDL_GetError());
+				ret = false;
+			}
+		}
 		else
 		{
 			if (fullscreen_window == true)